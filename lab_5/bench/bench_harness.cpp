@@ -0,0 +1,110 @@
+#include "bench_harness.h"
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+namespace bench {
+
+void Runner::run(const std::string& name, size_t items, const std::function<uint64_t()>& sample) {
+    if (!options.filter.empty() && name.find(options.filter) == std::string::npos) {
+        return;
+    }
+
+    uint64_t budget = static_cast<uint64_t>(options.min_time_sec * 1e9);
+    uint64_t total = 0;
+    uint64_t best = UINT64_MAX;
+    size_t iterations = 0;
+    do {
+        uint64_t elapsed = sample();
+        total += elapsed;
+        best = std::min(best, elapsed);
+        ++iterations;
+    } while (total < budget && iterations < 1000);
+
+    results.push_back({name, iterations, items, static_cast<double>(best),
+                       static_cast<double>(total) / static_cast<double>(iterations)});
+    const Result& r = results.back();
+    std::cout << std::left << std::setw(56) << r.name << std::right << std::setw(14) << std::fixed
+              << std::setprecision(2) << r.best_ns / static_cast<double>(std::max<size_t>(r.items, 1))
+              << " ns/item" << std::setw(8) << r.iterations << " iters\n";
+}
+
+// Формат близок к выводу Google Benchmark, чтобы подходили существующие скрипты сравнения
+void Runner::write_json(std::ostream& os) const {
+    std::time_t now = std::time(nullptr);
+    char date[32];
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    os << "{\n  \"context\": {\n    \"date\": \"" << date << "\",\n    \"label\": \"" << options.label
+       << "\",\n    \"size\": " << options.size << "\n  },\n  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        double per_item = r.best_ns / static_cast<double>(std::max<size_t>(r.items, 1));
+        os << (i ? "," : "") << "\n    {\"name\": \"" << r.name << "\", \"iterations\": " << r.iterations
+           << ", \"items\": " << r.items << ", \"real_time\": " << r.best_ns << ", \"mean_time\": " << r.mean_ns
+           << ", \"time_unit\": \"ns\", \"ns_per_item\": " << per_item
+           << ", \"items_per_second\": " << (per_item > 0 ? 1e9 / per_item : 0.0) << "}";
+    }
+    os << "\n  ]\n}\n";
+}
+
+Options parse_options(int argc, char** argv) {
+    Options opts;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("missing value for " + arg);
+            }
+            return argv[++i];
+        };
+        if (arg == "--filter") {
+            opts.filter = value();
+        } else if (arg == "--json") {
+            opts.json_path = value();
+        } else if (arg == "--label") {
+            opts.label = value();
+        } else if (arg == "--size") {
+            opts.size = std::stoul(value());
+        } else if (arg == "--min-time") {
+            opts.min_time_sec = std::stod(value());
+        } else if (arg == "--threads") {
+            opts.max_threads = std::stoul(value());
+        } else {
+            throw std::invalid_argument("unknown argument " + arg);
+        }
+    }
+    return opts;
+}
+
+} // namespace bench
+
+int main(int argc, char** argv) {
+    try {
+        bench::Runner runner(bench::parse_options(argc, argv));
+
+        bench::run_container_benchmarks(runner);
+        bench::run_soa_benchmarks(runner);
+        bench::run_concurrent_benchmarks(runner);
+        bench::run_parallel_benchmarks(runner);
+        bench::run_sort_benchmarks(runner);
+        bench::run_defragment_benchmarks(runner);
+        bench::run_ingest_benchmarks(runner);
+
+        if (!runner.opts().json_path.empty()) {
+            std::ofstream out(runner.opts().json_path);
+            if (!out) {
+                throw std::runtime_error("cannot open " + runner.opts().json_path);
+            }
+            runner.write_json(out);
+        }
+    } catch (const std::exception& err) {
+        std::cerr << "benchmarks: " << err.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
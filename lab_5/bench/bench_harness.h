@@ -0,0 +1,112 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// === Простой самодостаточный бенчмарк-харнесс ===
+// Каждый замер - функция, которая сама готовит данные и возвращает время
+// измеряемой части в наносекундах (см. measure). Замер повторяется, пока суммарное
+// время не превысит min_time, в отчёт попадает лучший и средний результат.
+namespace bench {
+
+struct Options {
+    std::string filter;          // подстрока имени; пустая - запускать всё
+    std::string json_path;       // куда записать JSON; пустой - не записывать
+    std::string label;           // метка запуска (например, хеш коммита)
+    size_t size = 100000;        // базовое число элементов
+    double min_time_sec = 0.2;   // минимальное суммарное время одного замера
+    size_t max_threads = 0;      // верхняя граница числа потоков (0 - до 64)
+};
+
+struct Result {
+    std::string name;
+    size_t iterations;
+    size_t items;
+    double best_ns;
+    double mean_ns;
+};
+
+// Структура из демонстрации в main.cpp - типичная запись нашей нагрузки
+struct Employee {
+    std::string name;
+    int id;
+    double salary;
+
+    Employee(const std::string& n = "", int i = 0, double s = 0.0) : name(n), id(i), salary(s) {}
+};
+
+template<typename T>
+T make_value(size_t i);
+
+template<>
+inline int make_value<int>(size_t i) {
+    return static_cast<int>(i * 2654435761u);
+}
+
+template<>
+inline std::string make_value<std::string>(size_t i) {
+    // длиннее SSO-буфера, чтобы строка выделяла память
+    return "employee-name-" + std::to_string(i) + "-padding-padding";
+}
+
+template<>
+inline Employee make_value<Employee>(size_t i) {
+    return Employee(make_value<std::string>(i), static_cast<int>(i), 1000.0 + static_cast<double>(i % 977));
+}
+
+template<typename T>
+const char* type_name();
+
+template<> inline const char* type_name<int>() { return "int"; }
+template<> inline const char* type_name<std::string>() { return "string"; }
+template<> inline const char* type_name<Employee>() { return "Employee"; }
+
+// Время выполнения body в наносекундах
+template<typename Body>
+uint64_t measure(Body&& body) {
+    auto start = std::chrono::steady_clock::now();
+    body();
+    auto finish = std::chrono::steady_clock::now();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start).count());
+}
+
+// Не даёт компилятору выбросить вычисление результата
+template<typename T>
+inline void do_not_optimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+class Runner {
+public:
+    explicit Runner(Options opts) : options(std::move(opts)) {}
+
+    const Options& opts() const noexcept {
+        return options;
+    }
+
+    // items - число элементарных операций за один замер (для items_per_second)
+    void run(const std::string& name, size_t items, const std::function<uint64_t()>& sample);
+
+    void write_json(std::ostream& os) const;
+
+private:
+    Options options;
+    std::vector<Result> results;
+};
+
+Options parse_options(int argc, char** argv);
+
+// Наборы бенчмарков (по одному на исходный файл в bench/)
+void run_container_benchmarks(Runner& runner);
+void run_soa_benchmarks(Runner& runner);
+void run_concurrent_benchmarks(Runner& runner);
+void run_parallel_benchmarks(Runner& runner);
+void run_sort_benchmarks(Runner& runner);
+void run_defragment_benchmarks(Runner& runner);
+void run_ingest_benchmarks(Runner& runner);
+
+} // namespace bench
@@ -0,0 +1,91 @@
+#include "bench_harness.h"
+#include "vector.h"
+#include "concurrent_vector.h"
+#include "concurrent_memory_resource.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// === Конкурентное добавление: ConcurrentPmrVector против PmrVector под мьютексом ===
+// Общее число элементов фиксировано (--size) и делится между потоками: 1, 2, 4, ... 64
+// (верхнюю границу задаёт --threads)
+namespace bench {
+
+namespace {
+
+// Запускает body(thread_index, count) в threads потоках и меряет время от общего старта до последнего join
+template<typename Body>
+uint64_t run_threads(size_t threads, size_t total, Body&& body) {
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    std::atomic<bool> start{false};
+    std::atomic<size_t> ready{0};
+    for (size_t t = 0; t < threads; ++t) {
+        size_t count = total / threads + (t < total % threads ? 1 : 0);
+        workers.emplace_back([&, t, count] {
+            ready.fetch_add(1);
+            while (!start.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            body(t, count);
+        });
+    }
+    while (ready.load() != threads) {
+        std::this_thread::yield();
+    }
+    return measure([&] {
+        start.store(true, std::memory_order_release);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    });
+}
+
+} // namespace
+
+void run_concurrent_benchmarks(Runner& runner) {
+    const size_t n = runner.opts().size;
+    const size_t max_threads = runner.opts().max_threads ? runner.opts().max_threads : 64;
+
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        std::string suffix = "/threads:" + std::to_string(threads);
+
+        runner.run("concurrent_push_back/ConcurrentPmrVector<int>" + suffix, n, [&] {
+            my_vector::ConcurrentListMemoryResource resource;
+            my_vector::ConcurrentPmrVector<int> vec(&resource);
+            return run_threads(threads, n, [&](size_t t, size_t count) {
+                for (size_t i = 0; i < count; ++i) {
+                    vec.push_back(make_value<int>(t * n + i));
+                }
+            });
+        });
+
+        runner.run("concurrent_push_back/ConcurrentPmrVector<string>" + suffix, n, [&] {
+            my_vector::ConcurrentListMemoryResource resource;
+            my_vector::ConcurrentPmrVector<std::string> vec(&resource);
+            return run_threads(threads, n, [&](size_t t, size_t count) {
+                for (size_t i = 0; i < count; ++i) {
+                    vec.push_back(make_value<std::string>(t * n + i));
+                }
+            });
+        });
+
+        // Базовая линия: обычный PmrVector, доступ сериализован мьютексом
+        runner.run("concurrent_push_back/PmrVector<int>+mutex" + suffix, n, [&] {
+            my_vector::ConcurrentListMemoryResource resource;
+            my_vector::PmrVector<int> vec(&resource);
+            std::mutex mutex;
+            return run_threads(threads, n, [&](size_t t, size_t count) {
+                for (size_t i = 0; i < count; ++i) {
+                    int value = make_value<int>(t * n + i);
+                    std::lock_guard<std::mutex> lock(mutex);
+                    vec.push_back(value);
+                }
+            });
+        });
+    }
+}
+
+} // namespace bench
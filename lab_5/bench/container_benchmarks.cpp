@@ -0,0 +1,186 @@
+#include "bench_harness.h"
+#include "vector.h"
+#include "dense_vector.h"
+#include "my_memory_resource.h"
+#include <memory>
+#include <memory_resource>
+#include <random>
+#include <string>
+#include <vector>
+
+// === Сравнение PmrVector/PmrDenseVector поверх ListMemoryResource со std::pmr::vector ===
+namespace bench {
+
+namespace {
+
+// Окружение одного замера: ресурс и контейнер поверх него
+template<typename T>
+struct ListEnv {
+    static constexpr const char* name = "PmrVector/List";
+    my_vector::ListMemoryResource resource;
+    my_vector::PmrVector<T> vec{&resource};
+};
+
+template<typename T>
+struct DenseEnv {
+    static constexpr const char* name = "PmrDenseVector/List";
+    my_vector::ListMemoryResource resource;
+    my_vector::PmrDenseVector<T> vec{&resource};
+};
+
+template<typename T>
+struct PoolEnv {
+    static constexpr const char* name = "std::pmr::vector/unsync_pool";
+    std::pmr::unsynchronized_pool_resource resource;
+    std::pmr::vector<T> vec{&resource};
+};
+
+template<typename T>
+struct MonotonicEnv {
+    static constexpr const char* name = "std::pmr::vector/monotonic";
+    std::pmr::monotonic_buffer_resource resource;
+    std::pmr::vector<T> vec{&resource};
+};
+
+template<typename T>
+struct NewDeleteEnv {
+    static constexpr const char* name = "std::pmr::vector/new_delete";
+    std::pmr::vector<T> vec{std::pmr::new_delete_resource()};
+};
+
+// Вставка/удаление по индексу: у наших контейнеров индекс, у std::vector - итератор
+template<typename Container, typename T>
+void insert_at(Container& c, size_t index, const T& value) {
+    if constexpr (requires { c.insert(index, value); }) {
+        c.insert(index, value);
+    } else {
+        c.insert(c.begin() + static_cast<std::ptrdiff_t>(index), value);
+    }
+}
+
+template<typename Container>
+void erase_at(Container& c, size_t index) {
+    if constexpr (requires { c.erase(index); }) {
+        c.erase(index);
+    } else {
+        c.erase(c.begin() + static_cast<std::ptrdiff_t>(index));
+    }
+}
+
+inline size_t touch(int value) { return static_cast<size_t>(value); }
+inline size_t touch(const std::string& value) { return value.size(); }
+inline size_t touch(const Employee& value) { return static_cast<size_t>(value.id); }
+
+template<typename T>
+std::vector<T> make_values(size_t count) {
+    std::vector<T> values;
+    values.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        values.push_back(make_value<T>(i));
+    }
+    return values;
+}
+
+template<template<typename> class Env, typename T>
+void run_suite(Runner& runner, const std::vector<T>& values, const std::vector<size_t>& random_indices) {
+    const size_t n = values.size();
+    const std::string prefix = std::string(Env<T>::name) + "/" + type_name<T>() + "/";
+
+    auto filled = [&]() {
+        auto env = std::make_unique<Env<T>>();
+        for (const T& value : values) {
+            env->vec.push_back(value);
+        }
+        return env;
+    };
+
+    runner.run(prefix + "push_back", n, [&] {
+        auto env = std::make_unique<Env<T>>();
+        return measure([&] {
+            for (const T& value : values) {
+                env->vec.push_back(value);
+            }
+        });
+    });
+
+    runner.run(prefix + "random_access", n, [&] {
+        auto env = filled();
+        return measure([&] {
+            size_t sum = 0;
+            for (size_t index : random_indices) {
+                sum += touch(env->vec[index]);
+            }
+            do_not_optimize(sum);
+        });
+    });
+
+    runner.run(prefix + "iterate", n, [&] {
+        auto env = filled();
+        return measure([&] {
+            size_t sum = 0;
+            for (const T& value : env->vec) {
+                sum += touch(value);
+            }
+            do_not_optimize(sum);
+        });
+    });
+
+    // Вставка/удаление в середину квадратичны по природе - берём меньший размер
+    const size_t middle_size = std::min<size_t>(n, 10000);
+    const size_t middle_ops = 1000;
+    runner.run(prefix + "insert_erase_middle", 2 * middle_ops, [&] {
+        auto env = std::make_unique<Env<T>>();
+        for (size_t i = 0; i < middle_size; ++i) {
+            env->vec.push_back(values[i]);
+        }
+        return measure([&] {
+            for (size_t i = 0; i < middle_ops; ++i) {
+                insert_at(env->vec, env->vec.size() / 2, values[i]);
+            }
+            for (size_t i = 0; i < middle_ops; ++i) {
+                erase_at(env->vec, env->vec.size() / 2);
+            }
+        });
+    });
+
+    constexpr size_t kCycles = 3;
+    runner.run(prefix + "clear_refill", kCycles * n, [&] {
+        auto env = filled();
+        return measure([&] {
+            for (size_t cycle = 0; cycle < kCycles; ++cycle) {
+                env->vec.clear();
+                for (const T& value : values) {
+                    env->vec.push_back(value);
+                }
+            }
+        });
+    });
+}
+
+template<typename T>
+void run_for_type(Runner& runner) {
+    const size_t n = runner.opts().size;
+    std::vector<T> values = make_values<T>(n);
+
+    std::mt19937_64 rng(42);
+    std::vector<size_t> random_indices(n);
+    for (size_t& index : random_indices) {
+        index = rng() % n;
+    }
+
+    run_suite<ListEnv>(runner, values, random_indices);
+    run_suite<DenseEnv>(runner, values, random_indices);
+    run_suite<PoolEnv>(runner, values, random_indices);
+    run_suite<MonotonicEnv>(runner, values, random_indices);
+    run_suite<NewDeleteEnv>(runner, values, random_indices);
+}
+
+} // namespace
+
+void run_container_benchmarks(Runner& runner) {
+    run_for_type<int>(runner);
+    run_for_type<std::string>(runner);
+    run_for_type<Employee>(runner);
+}
+
+} // namespace bench
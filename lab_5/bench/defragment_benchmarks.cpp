@@ -0,0 +1,56 @@
+#include "bench_harness.h"
+#include "vector.h"
+#include "my_memory_resource.h"
+#include <functional>
+#include <random>
+
+// === Скан PmrVector<Employee> до и после defragment() ===
+// Порядок элементов перемешивается перестановкой таблицы указателей - так выглядит вектор
+// после долгой серии insert/erase: соседние индексы указывают в разные места памяти
+namespace bench {
+
+namespace {
+
+double sum_salary(const my_vector::PmrVector<Employee>& vec) {
+    double total = 0.0;
+    for (const Employee& e : vec) {
+        total += e.salary;
+    }
+    return total;
+}
+
+void scatter(my_vector::PmrVector<Employee>& vec, unsigned seed) {
+    std::mt19937_64 rng(seed);
+    const uint64_t salt = rng();
+    vec.sort({}, [salt](const Employee& e) { return std::hash<uint64_t>{}(static_cast<uint64_t>(e.id) ^ salt) * 0x9E3779B97F4A7C15ull; });
+}
+
+} // namespace
+
+void run_defragment_benchmarks(Runner& runner) {
+    const size_t n = runner.opts().size * 10;
+
+    my_vector::ListMemoryResource resource;
+    my_vector::PmrVector<Employee> vec(&resource);
+    vec.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        vec.push_back(make_value<Employee>(i));
+    }
+
+    scatter(vec, 1);
+    runner.run("defragment/PmrVector<Employee>/scan_scattered", n, [&] {
+        return measure([&] { do_not_optimize(sum_salary(vec)); });
+    });
+
+    unsigned seed = 2;
+    runner.run("defragment/PmrVector<Employee>/defragment", n, [&] {
+        scatter(vec, seed++);
+        return measure([&] { do_not_optimize(vec.defragment()); });
+    });
+
+    runner.run("defragment/PmrVector<Employee>/scan_defragmented", n, [&] {
+        return measure([&] { do_not_optimize(sum_salary(vec)); });
+    });
+}
+
+} // namespace bench
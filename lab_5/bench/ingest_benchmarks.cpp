@@ -0,0 +1,120 @@
+#include "bench_harness.h"
+#include "ingest.h"
+#include "my_memory_resource.h"
+#include <memory_resource>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+// === Загрузка записей Employee из текста с разделителями ===
+// items - байты входа: ns/item на консоли - наносекунды на байт (MB/s = 1000 / ns/item),
+// items_per_second в JSON - байты в секунду
+namespace bench {
+
+namespace {
+
+// Запись с именем в ресурсе вектора
+struct PmrEmployee {
+    std::pmr::string name;
+    int id;
+    double salary;
+
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+    PmrEmployee(std::string_view n, int i, double s, const allocator_type& alloc = {})
+        : name(n, alloc), id(i), salary(s) {}
+    PmrEmployee(const PmrEmployee& other, const allocator_type& alloc = {})
+        : name(other.name, alloc), id(other.id), salary(other.salary) {}
+};
+
+struct PlainEmployee {
+    int id;
+    double salary;
+};
+
+std::string make_csv(size_t n) {
+    std::string csv = "name,id,salary\n";
+    for (size_t i = 0; i < n; ++i) {
+        Employee e = make_value<Employee>(i);
+        csv += e.name + "," + std::to_string(e.id) + "," + std::to_string(e.salary) + "\n";
+    }
+    return csv;
+}
+
+// Как раньше: getline, временная запись, push_back на каждую запись. Обе схемы пишут
+// строки в ресурс вектора, различается только путь от байтов до элемента
+template<typename Resource>
+void run_csv_benchmarks(Runner& runner, const std::string& csv, const std::string& resource_name) {
+    runner.run("ingest/csv/" + resource_name + "/getline_push_back", csv.size(), [&] {
+        Resource resource;
+        my_vector::PmrVector<PmrEmployee> vec(&resource);
+        std::istringstream in(csv);
+        return measure([&] {
+            std::string line;
+            std::getline(in, line);
+            while (std::getline(in, line)) {
+                size_t first = line.find(',');
+                size_t second = line.find(',', first + 1);
+                PmrEmployee e(line.substr(0, first), std::stoi(line.substr(first + 1, second - first - 1)),
+                              std::stod(line.substr(second + 1)));
+                vec.push_back(e);
+            }
+            do_not_optimize(vec.size());
+        });
+    });
+
+    runner.run("ingest/csv/" + resource_name + "/ingest_delimited", csv.size(), [&] {
+        Resource resource;
+        my_vector::PmrVector<PmrEmployee> vec(&resource);
+        std::istringstream in(csv);
+        my_vector::IngestOptions options;
+        options.skip_header = true;
+        return measure([&] {
+            my_vector::ingest_delimited(in, vec, [](auto& v, std::span<const std::string_view> fields) {
+                v.emplace_back(fields[0], my_vector::parse_field<int>(fields[1]),
+                               my_vector::parse_field<double>(fields[2]));
+            }, options);
+            do_not_optimize(vec.size());
+        });
+    });
+}
+
+} // namespace
+
+void run_ingest_benchmarks(Runner& runner) {
+    const size_t n = runner.opts().size * 10;
+    const std::string csv = make_csv(n);
+    run_csv_benchmarks<my_vector::ListMemoryResource>(runner, csv, "list");
+    run_csv_benchmarks<std::pmr::unsynchronized_pool_resource>(runner, csv, "pool");
+
+    std::string binary;
+    binary.reserve(n * sizeof(PlainEmployee));
+    for (size_t i = 0; i < n; ++i) {
+        PlainEmployee e{static_cast<int>(i), 1000.0 + static_cast<double>(i % 977)};
+        binary.append(reinterpret_cast<const char*>(&e), sizeof(e));
+    }
+
+    runner.run("ingest/binary/read_push_back", binary.size(), [&] {
+        my_vector::ListMemoryResource resource;
+        my_vector::PmrVector<PlainEmployee> vec(&resource);
+        std::istringstream in(binary);
+        return measure([&] {
+            PlainEmployee e;
+            while (in.read(reinterpret_cast<char*>(&e), sizeof(e))) {
+                vec.push_back(e);
+            }
+            do_not_optimize(vec.size());
+        });
+    });
+
+    runner.run("ingest/binary/ingest_binary", binary.size(), [&] {
+        my_vector::ListMemoryResource resource;
+        my_vector::PmrVector<PlainEmployee> vec(&resource);
+        std::istringstream in(binary);
+        return measure([&] {
+            my_vector::ingest_binary(in, vec);
+            do_not_optimize(vec.size());
+        });
+    });
+}
+
+} // namespace bench
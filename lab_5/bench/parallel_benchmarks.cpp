@@ -0,0 +1,71 @@
+#include "bench_harness.h"
+#include "vector.h"
+#include "parallel.h"
+#include "my_memory_resource.h"
+#include <algorithm>
+#include <thread>
+
+// === Масштабирование параллельных алгоритмов по числу потоков ===
+// threads:1 - последовательный цикл без пула, дальше пул из threads-1 рабочих
+// (вызывающий поток работает как ещё один); верхняя граница - --threads или число ядер
+namespace bench {
+
+void run_parallel_benchmarks(Runner& runner) {
+    const size_t n = runner.opts().size * 10;
+    const size_t max_threads = runner.opts().max_threads ? runner.opts().max_threads
+                                                         : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+    my_vector::ListMemoryResource resource;
+    my_vector::PmrVector<Employee> staff(&resource);
+    staff.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        staff.push_back(make_value<Employee>(i));
+    }
+    my_vector::PmrVector<double> bonuses(&resource);
+    bonuses.resize(n);
+
+    runner.run("parallel/reduce_salary/sequential", n, [&] {
+        return measure([&] {
+            double total = 0.0;
+            for (const Employee& e : staff) {
+                total += e.salary;
+            }
+            do_not_optimize(total);
+        });
+    });
+
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        my_vector::parallel::ThreadPool pool(threads - 1);
+        std::string suffix = "/threads:" + std::to_string(threads);
+
+        runner.run("parallel/reduce_salary" + suffix, n, [&] {
+            return measure([&] {
+                do_not_optimize(my_vector::parallel::reduce(pool, staff, 0.0, std::plus<>{}, &Employee::salary));
+            });
+        });
+
+        runner.run("parallel/count_if_salary" + suffix, n, [&] {
+            return measure([&] {
+                do_not_optimize(my_vector::parallel::count_if(pool, staff, [](const Employee& e) {
+                    return e.salary > 1500.0;
+                }));
+            });
+        });
+
+        runner.run("parallel/for_each_raise" + suffix, n, [&] {
+            return measure([&] {
+                my_vector::parallel::for_each(pool, staff, [](Employee& e) { e.salary *= 1.0001; });
+            });
+        });
+
+        runner.run("parallel/transform_bonus" + suffix, n, [&] {
+            return measure([&] {
+                my_vector::parallel::transform(pool, staff, bonuses, [](const Employee& e) {
+                    return e.salary * 0.1 + static_cast<double>(e.name.size());
+                });
+            });
+        });
+    }
+}
+
+} // namespace bench
@@ -0,0 +1,100 @@
+#include "recording_resource.h"
+#include "my_memory_resource.h"
+#include "concurrent_memory_resource.h"
+#include <memory_resource>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#if __has_include(<sys/resource.h>)
+#include <sys/resource.h>
+#define REPLAY_HAS_RUSAGE 1
+#endif
+
+// === Воспроизведение записанной трассы аллокаций на выбранном ресурсе ===
+// ./replay trace.bin [--resource list|new_delete|pool|sync_pool|monotonic|concurrent] [--repeat N]
+// Трасса записывается через RecordingResource (например, ./lab5_exe --record trace.bin).
+// Один ресурс на запуск - тогда пиковый RSS процесса относится только к нему.
+
+namespace {
+
+std::unique_ptr<std::pmr::memory_resource> make_resource(const std::string& name) {
+    if (name == "list") {
+        return std::make_unique<my_vector::ListMemoryResource>();
+    }
+    if (name == "pool") {
+        return std::make_unique<std::pmr::unsynchronized_pool_resource>();
+    }
+    if (name == "sync_pool") {
+        return std::make_unique<std::pmr::synchronized_pool_resource>();
+    }
+    if (name == "monotonic") {
+        return std::make_unique<std::pmr::monotonic_buffer_resource>();
+    }
+    if (name == "concurrent") {
+        return std::make_unique<my_vector::ConcurrentListMemoryResource>();
+    }
+    throw std::invalid_argument("unknown resource " + name);
+}
+
+// Пиковый RSS процесса в КиБ (0 - недоступно на этой платформе)
+long peak_rss_kib() {
+#ifdef REPLAY_HAS_RUSAGE
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        return usage.ru_maxrss;
+    }
+#endif
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        std::string path;
+        std::string resource_name = "list";
+        size_t repeat = 1;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--resource" && i + 1 < argc) {
+                resource_name = argv[++i];
+            } else if (arg == "--repeat" && i + 1 < argc) {
+                repeat = std::stoul(argv[++i]);
+            } else if (path.empty() && arg.rfind("--", 0) != 0) {
+                path = arg;
+            } else {
+                throw std::invalid_argument("unknown argument " + arg);
+            }
+        }
+        if (path.empty()) {
+            throw std::invalid_argument("usage: replay trace.bin [--resource name] [--repeat N]");
+        }
+
+        my_vector::AllocationTrace trace = my_vector::AllocationTrace::read(path);
+        long rss_before = peak_rss_kib();
+
+        // ресурс живёт все повторы: второй и следующие проходы показывают работу на "прогретом" ресурсе
+        std::unique_ptr<std::pmr::memory_resource> resource =
+            resource_name == "new_delete" ? nullptr : make_resource(resource_name);
+        std::pmr::memory_resource* target = resource ? resource.get() : std::pmr::new_delete_resource();
+
+        std::cout << "trace: " << trace.records.size() << " operations, " << trace.allocation_count
+                  << " allocations; resource: " << resource_name << '\n';
+        for (size_t run = 0; run < repeat; ++run) {
+            my_vector::ReplayResult result = my_vector::replay(trace, target);
+            std::cout << "run " << run << ": " << std::fixed << std::setprecision(2)
+                      << result.ops_per_second() / 1e6 << " Mops/s, " << result.seconds * 1e3 << " ms, reuse "
+                      << result.reuse_rate * 100.0 << "%, unfreed " << result.leaked << '\n';
+        }
+
+        long rss_after = peak_rss_kib();
+        std::cout << "peak RSS: " << rss_after << " KiB (+" << (rss_after - rss_before) << " KiB during replay)\n";
+    } catch (const std::exception& err) {
+        std::cerr << "replay: " << err.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
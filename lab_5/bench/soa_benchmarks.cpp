@@ -0,0 +1,99 @@
+#include "bench_harness.h"
+#include "vector.h"
+#include "dense_vector.h"
+#include "soa_vector.h"
+#include "my_memory_resource.h"
+#include <algorithm>
+#include <limits>
+
+// === Скан полей Employee: AoS (PmrVector/PmrDenseVector) против SoA (PmrSoAVector) ===
+namespace bench {
+
+namespace {
+
+using EmployeeColumns = my_vector::PmrSoAVector<Employee, &Employee::name, &Employee::id, &Employee::salary>;
+
+constexpr double kThreshold = 1500.0;
+
+} // namespace
+
+void run_soa_benchmarks(Runner& runner) {
+    const size_t n = runner.opts().size;
+
+    my_vector::ListMemoryResource resource;
+    my_vector::PmrVector<Employee> aos(&resource);
+    my_vector::PmrDenseVector<Employee> dense(&resource);
+    EmployeeColumns soa(&resource);
+    aos.reserve(n);
+    dense.reserve(n);
+    soa.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        Employee e = make_value<Employee>(i);
+        aos.push_back(e);
+        dense.push_back(e);
+        soa.push_back(e);
+    }
+
+    runner.run("scan/PmrVector<Employee>/sum_salary", n, [&] {
+        return measure([&] {
+            double total = 0.0;
+            for (const Employee& e : aos) {
+                total += e.salary;
+            }
+            do_not_optimize(total);
+        });
+    });
+
+    runner.run("scan/PmrDenseVector<Employee>/sum_salary", n, [&] {
+        return measure([&] {
+            double total = 0.0;
+            for (const Employee& e : dense) {
+                total += e.salary;
+            }
+            do_not_optimize(total);
+        });
+    });
+
+    runner.run("scan/PmrSoAVector<Employee>/sum_salary", n, [&] {
+        return measure([&] { do_not_optimize(soa.sum<&Employee::salary>()); });
+    });
+
+    runner.run("scan/PmrVector<Employee>/max_id", n, [&] {
+        return measure([&] {
+            int best = std::numeric_limits<int>::lowest();
+            for (const Employee& e : aos) {
+                best = std::max(best, e.id);
+            }
+            do_not_optimize(best);
+        });
+    });
+
+    runner.run("scan/PmrSoAVector<Employee>/max_id", n, [&] {
+        return measure([&] { do_not_optimize(soa.max<&Employee::id>()); });
+    });
+
+    runner.run("scan/PmrVector<Employee>/count_salary_gt", n, [&] {
+        return measure([&] {
+            size_t count = 0;
+            for (const Employee& e : aos) {
+                count += e.salary > kThreshold;
+            }
+            do_not_optimize(count);
+        });
+    });
+
+    runner.run("scan/PmrSoAVector<Employee>/count_salary_gt", n, [&] {
+        return measure([&] {
+            do_not_optimize(soa.count_if<&Employee::salary>([](double s) { return s > kThreshold; }));
+        });
+    });
+
+    runner.run("scan/PmrSoAVector<Employee>/filter_salary_gt", n, [&] {
+        return measure([&] {
+            auto rows = soa.filter<&Employee::salary>([](double s) { return s > kThreshold; });
+            do_not_optimize(rows.size());
+        });
+    });
+}
+
+} // namespace bench
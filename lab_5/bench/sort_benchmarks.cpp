@@ -0,0 +1,123 @@
+#include "bench_harness.h"
+#include "vector.h"
+#include "dense_vector.h"
+#include "my_memory_resource.h"
+#include <algorithm>
+#include <array>
+#include <random>
+#include <string>
+#include <vector>
+
+// === Переупорядочивание записей: перестановка указателей PmrVector против std-алгоритмов ===
+// === над PmrDenseVector, которые перемещают сами записи ===
+// Перед каждым замером порядок записей заново перемешивается (вне измеряемой части)
+namespace bench {
+
+namespace {
+
+struct ById {
+    template<typename Record>
+    bool operator()(const Record& a, const Record& b) const {
+        return a.id < b.id;
+    }
+};
+
+// Тяжёлая запись: перемещение - копирование 264 байт, перестановка указателей выигрывает сильнее
+struct WideRecord {
+    int id = 0;
+    std::array<double, 32> payload{};
+};
+
+template<typename Record>
+Record make_record(size_t i);
+
+template<>
+Employee make_record<Employee>(size_t i) {
+    return make_value<Employee>(i);
+}
+
+template<>
+WideRecord make_record<WideRecord>(size_t i) {
+    WideRecord record;
+    record.id = static_cast<int>(i);
+    record.payload.fill(static_cast<double>(i));
+    return record;
+}
+
+template<typename Record>
+void run_sort_suite(Runner& runner, const std::string& type, size_t n) {
+    // один и тот же случайный порядок id для обоих контейнеров
+    std::vector<size_t> order(n);
+    for (size_t i = 0; i < n; ++i) {
+        order[i] = i;
+    }
+    std::shuffle(order.begin(), order.end(), std::mt19937(42));
+
+    my_vector::ListMemoryResource resource;
+    my_vector::PmrVector<Record> pointers(&resource);
+    my_vector::PmrDenseVector<Record> dense(&resource);
+    pointers.reserve(n);
+    dense.reserve(n);
+    for (size_t i : order) {
+        pointers.push_back(make_record<Record>(i));
+        dense.push_back(make_record<Record>(i));
+    }
+
+    std::mt19937 rng(7);
+    auto reshuffle = [&] {
+        std::shuffle(pointers.begin(), pointers.end(), rng);
+        std::shuffle(dense.begin(), dense.end(), rng);
+    };
+    const std::string dense_name = "/PmrDenseVector<" + type + ">/";
+    const std::string pointer_name = "/PmrVector<" + type + ">/";
+
+    runner.run("sort" + dense_name + "std::sort", n, [&] {
+        reshuffle();
+        return measure([&] { std::sort(dense.begin(), dense.end(), ById{}); });
+    });
+    runner.run("sort" + pointer_name + "sort", n, [&] {
+        reshuffle();
+        return measure([&] { pointers.sort({}, &Record::id); });
+    });
+
+    runner.run("stable_sort" + dense_name + "std::stable_sort", n, [&] {
+        reshuffle();
+        return measure([&] { std::stable_sort(dense.begin(), dense.end(), ById{}); });
+    });
+    runner.run("stable_sort" + pointer_name + "stable_sort", n, [&] {
+        reshuffle();
+        return measure([&] { pointers.stable_sort({}, &Record::id); });
+    });
+
+    runner.run("nth_element" + dense_name + "std::nth_element", n, [&] {
+        reshuffle();
+        return measure([&] { std::nth_element(dense.begin(), dense.begin() + n / 2, dense.end(), ById{}); });
+    });
+    runner.run("nth_element" + pointer_name + "nth_element", n, [&] {
+        reshuffle();
+        return measure([&] { pointers.nth_element(n / 2, {}, &Record::id); });
+    });
+
+    const int middle = static_cast<int>(n / 2);
+    runner.run("partition" + dense_name + "std::partition", n, [&] {
+        reshuffle();
+        return measure([&] {
+            do_not_optimize(std::partition(dense.begin(), dense.end(), [middle](const Record& r) { return r.id < middle; }));
+        });
+    });
+    runner.run("partition" + pointer_name + "partition", n, [&] {
+        reshuffle();
+        return measure([&] {
+            do_not_optimize(pointers.partition([middle](int id) { return id < middle; }, &Record::id));
+        });
+    });
+}
+
+} // namespace
+
+void run_sort_benchmarks(Runner& runner) {
+    run_sort_suite<Employee>(runner, "Employee", runner.opts().size);
+    run_sort_suite<WideRecord>(runner, "WideRecord", runner.opts().size);
+}
+
+} // namespace bench
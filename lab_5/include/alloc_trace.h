@@ -0,0 +1,90 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// === Трассировка аллокаций ===
+// При сборке без MY_VECTOR_ALLOC_TRACE (опция CMake LAB5_ALLOC_TRACE) макрос
+// MY_VECTOR_TRACE раскрывается в пустое выражение и не стоит ничего в горячем пути
+#ifdef MY_VECTOR_ALLOC_TRACE
+#define MY_VECTOR_TRACE(trace, ...)            \
+    do {                                       \
+        if (trace) (trace)->record(__VA_ARGS__); \
+    } while (0)
+#else
+#define MY_VECTOR_TRACE(trace, ...) ((void)0)
+#endif
+
+namespace my_vector {
+
+enum class TraceOp : uint8_t {
+    Allocate,   // новый блок
+    Reuse,      // переиспользованный блок
+    Deallocate, // блок помечен свободным
+    Cleanup     // блок возвращён системе
+};
+
+struct TraceEvent {
+    uint64_t timestamp_ns;
+    const void* ptr;
+    uint64_t size;
+    uint32_t alignment;
+    TraceOp op;
+};
+
+// Кольцевой буфер бинарных событий фиксированного размера.
+// Запись lock-free (fetch_add по голове + seqlock на слоте), при переполнении
+// самые старые события перезаписываются. Вычитывать буфер должен один поток.
+class AllocTrace {
+public:
+    static constexpr size_t kDefaultCapacity = size_t{1} << 16;
+
+    explicit AllocTrace(size_t capacity = kDefaultCapacity);
+
+    AllocTrace(const AllocTrace&) = delete;
+    AllocTrace& operator=(const AllocTrace&) = delete;
+
+    void record(TraceOp op, const void* ptr, size_t size, size_t alignment) noexcept;
+
+    // Забирает из буфера все опубликованные события, возвращает их количество
+    size_t drain(std::vector<TraceEvent>& out);
+
+    // Сколько событий было потеряно из-за переполнения буфера
+    uint64_t dropped() const noexcept { 
+        return lost;
+    }
+
+    size_t capacity() const noexcept {
+        return mask + 1;
+    }
+
+    // Вычитывание в текстовом виде и в формате Chrome trace (chrome://tracing, Perfetto)
+    void dump_text(std::ostream& os);
+    void dump_chrome_json(std::ostream& os);
+    void dump_text(const std::string& path);
+    void dump_chrome_json(const std::string& path);
+
+private:
+    // Событие хранится словами-атомиками, чтобы чтение параллельно с записью не было гонкой
+    static constexpr size_t kEventWords = (sizeof(TraceEvent) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    static_assert(sizeof(TraceEvent) == kEventWords * sizeof(uint64_t));
+
+    struct Slot {
+        std::atomic<uint64_t> seq{0}; // 2*pos+1 - идёт запись, 2*pos+2 - событие pos опубликовано
+        std::atomic<uint64_t> words[kEventWords] = {};
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    size_t mask;
+    std::atomic<uint64_t> head{0};
+    uint64_t tail = 0;
+    uint64_t lost = 0;
+};
+
+const char* to_string(TraceOp op) noexcept;
+
+} // namespace my_vector
@@ -0,0 +1,96 @@
+#pragma once
+#include <memory_resource>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace my_vector {
+
+// === Потокобезопасный вариант ListMemoryResource ===
+// Каждый поток держит свой кэш свободных блоков по size-классам (степени двойки)
+// и работает с ним без блокировок. Общий пул под мьютексом нужен только для
+// пополнения/сброса кэша пачками и для выделения новой памяти у системы.
+// Блок можно освобождать в любом потоке - он попадёт в кэш освобождающего потока.
+// При завершении потока его кэш автоматически возвращается в общий пул.
+class ConcurrentListMemoryResource : public std::pmr::memory_resource {
+public:
+    ConcurrentListMemoryResource();
+    ~ConcurrentListMemoryResource();
+
+    ConcurrentListMemoryResource(const ConcurrentListMemoryResource&) = delete;
+    ConcurrentListMemoryResource& operator=(const ConcurrentListMemoryResource&) = delete;
+
+    // Возвращает кэш текущего потока в общий пул (при завершении потока - автоматически)
+    void flush_thread_cache();
+
+    // === Метрики ===
+    // Свободные байты в общем пуле (кэши работающих потоков не учитываются)
+    size_t free_bytes();
+    // Память, полученная у системы
+    size_t reserved_bytes();
+
+private:
+    friend struct ThreadCacheRegistry;
+
+    static constexpr size_t kSizeClasses = 64;
+    static constexpr size_t kMinSizeClass = 4;          // минимальный блок - 16 байт
+    static constexpr size_t kBatchBytes = 16 * 1024;     // объём одной пачки блоков
+    static constexpr size_t kMaxBatch = 64;
+
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    struct FreeList {
+        FreeNode* head = nullptr;
+        size_t count = 0;
+
+        void push(FreeNode* node) noexcept {
+            node->next = head;
+            head = node;
+            ++count;
+        }
+
+        FreeNode* pop() noexcept {
+            FreeNode* node = head;
+            head = node->next;
+            --count;
+            return node;
+        }
+    };
+
+    struct ThreadCache {
+        std::array<FreeList, kSizeClasses> bins;
+    };
+
+    struct Chunk {
+        void* ptr;
+        size_t size;
+        size_t alignment;
+    };
+
+    const uint64_t id; // уникален для каждого экземпляра, ключ thread_local-кэша потока
+
+    std::mutex central_mutex;
+    std::array<FreeList, kSizeClasses> central_bins;
+    std::vector<Chunk> chunks;
+    std::vector<std::unique_ptr<ThreadCache>> caches; // кэши потоков, ещё не завершившихся
+
+    static size_t size_class(size_t bytes, size_t alignment);
+    static size_t batch_size(size_t cls) noexcept;
+
+    ThreadCache* local_cache();
+    void release_cache(ThreadCache* cache) noexcept;
+    void refill(FreeList& bin, size_t cls);
+    void flush(FreeList& bin, size_t cls, size_t keep);
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+};
+
+} // namespace my_vector
@@ -0,0 +1,219 @@
+#pragma once
+#include <memory_resource>
+#include <memory>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace my_vector {
+
+// === Вектор с конкурентным добавлением ===
+// Элементы лежат в сегментах, которые никогда не перемещаются: сегмент k хранит
+// kFirstSegment << k элементов, таблица сегментов фиксированного размера создаётся вместе
+// с вектором. Поэтому рост не инвалидирует ссылки и индексы, а чтение уже опубликованного
+// элемента - это два обращения к памяти без блокировок и ожиданий (wait-free).
+//
+// push_back/emplace_back lock-free: индекс выдаётся через fetch_add, недостающий сегмент
+// устанавливается CAS-ом (проигравший поток возвращает свою память ресурсу).
+// Элемент становится видимым (published) после завершения конструктора.
+// memory_resource должен быть потокобезопасным (new_delete, ConcurrentListMemoryResource).
+template<typename T>
+class ConcurrentPmrVector {
+private:
+    using value_allocator_type = std::pmr::polymorphic_allocator<T>;
+    using value_traits = std::allocator_traits<value_allocator_type>;
+
+    enum class SlotState : uint8_t {
+        Empty,     // индекс выдан, элемент ещё конструируется
+        Published, // элемент готов к чтению
+        Failed     // конструктор бросил исключение - слот навсегда пуст
+    };
+
+    struct Slot {
+        std::atomic<SlotState> state{SlotState::Empty};
+        alignas(T) std::byte storage[sizeof(T)];
+
+        T* value() noexcept {
+            return std::launder(reinterpret_cast<T*>(storage));
+        }
+    };
+
+    static constexpr size_t kFirstSegmentLog = 3;
+    static constexpr size_t kFirstSegment = size_t{1} << kFirstSegmentLog;
+    static constexpr size_t kMaxSegments = 64 - kFirstSegmentLog;
+
+    // сегменты выделяются напрямую из ресурса, элементы конструируются через аллокатор
+    // (uses-allocator: pmr-строки и вложенные pmr-контейнеры получают тот же ресурс)
+    value_allocator_type val_alloc;
+    std::atomic<Slot*> segments[kMaxSegments] = {};
+    std::atomic<size_t> reserved{0};
+
+    static size_t segment_size(size_t segment) noexcept {
+        return kFirstSegment << segment;
+    }
+
+    // Индекс -> (сегмент, позиция в сегменте): сегмент k начинается с индекса F * (2^k - 1)
+    static std::pair<size_t, size_t> locate(size_t index) noexcept {
+        size_t shifted = index + kFirstSegment;
+        size_t segment = static_cast<size_t>(std::bit_width(shifted)) - 1 - kFirstSegmentLog;
+        return {segment, shifted - segment_size(segment)};
+    }
+
+    Slot* ensure_segment(size_t segment) {
+        Slot* current = segments[segment].load(std::memory_order_acquire);
+        if (current) {
+            return current;
+        }
+        size_t count = segment_size(segment);
+        auto* fresh = static_cast<Slot*>(val_alloc.resource()->allocate(count * sizeof(Slot), alignof(Slot)));
+        for (size_t i = 0; i < count; ++i) {
+            new (fresh + i) Slot;
+        }
+        if (segments[segment].compare_exchange_strong(current, fresh, std::memory_order_acq_rel,
+                                                      std::memory_order_acquire)) {
+            return fresh;
+        }
+        // сегмент уже установил другой поток
+        val_alloc.resource()->deallocate(fresh, count * sizeof(Slot), alignof(Slot));
+        return current;
+    }
+
+    Slot* find_slot(size_t index) const noexcept {
+        auto [segment, offset] = locate(index);
+        Slot* base = segments[segment].load(std::memory_order_acquire);
+        return base ? base + offset : nullptr;
+    }
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+
+    explicit ConcurrentPmrVector(std::pmr::memory_resource* res = std::pmr::get_default_resource())
+        : val_alloc(res) {}
+
+    ConcurrentPmrVector(const ConcurrentPmrVector&) = delete;
+    ConcurrentPmrVector& operator=(const ConcurrentPmrVector&) = delete;
+
+    // Вызывается, когда конкурентные операции уже завершены
+    ~ConcurrentPmrVector() {
+        size_t count = reserved.load(std::memory_order_acquire);
+        for (size_t segment = 0; segment < kMaxSegments; ++segment) {
+            Slot* base = segments[segment].load(std::memory_order_acquire);
+            if (!base) {
+                continue;
+            }
+            size_t first = kFirstSegment * ((size_t{1} << segment) - 1);
+            size_t seg_size = segment_size(segment);
+            for (size_t i = 0; i < seg_size && first + i < count; ++i) {
+                if (base[i].state.load(std::memory_order_relaxed) == SlotState::Published) {
+                    value_traits::destroy(val_alloc, base[i].value());
+                }
+            }
+            val_alloc.resource()->deallocate(base, seg_size * sizeof(Slot), alignof(Slot));
+        }
+    }
+
+    std::pmr::memory_resource* get_resource() const noexcept {
+        return val_alloc.resource();
+    }
+
+    // Конструирует элемент и возвращает его индекс; индекс и адрес не меняются до уничтожения вектора
+    template<typename... Args>
+    size_t emplace_back(Args&&... args) {
+        size_t index = reserved.fetch_add(1, std::memory_order_relaxed);
+        auto [segment, offset] = locate(index);
+        Slot& slot = ensure_segment(segment)[offset];
+        try {
+            value_traits::construct(val_alloc, reinterpret_cast<T*>(slot.storage), std::forward<Args>(args)...);
+        } catch (...) {
+            slot.state.store(SlotState::Failed, std::memory_order_release);
+            throw;
+        }
+        slot.state.store(SlotState::Published, std::memory_order_release);
+        return index;
+    }
+
+    size_t push_back(const T& value) {
+        return emplace_back(value);
+    }
+
+    size_t push_back(T&& value) {
+        return emplace_back(std::move(value));
+    }
+
+    // Заранее создаёт сегменты под count элементов, чтобы в горячем пути не было аллокаций
+    void reserve(size_t count) {
+        if (count == 0) {
+            return;
+        }
+        size_t last_segment = locate(count - 1).first;
+        for (size_t segment = 0; segment <= last_segment; ++segment) {
+            ensure_segment(segment);
+        }
+    }
+
+    // Число выданных индексов; элементы с индексом меньше size() могут ещё конструироваться
+    size_t size() const noexcept {
+        return reserved.load(std::memory_order_acquire);
+    }
+
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    // Опубликованный элемент или nullptr (индекс не выдан, элемент ещё конструируется
+    // или его конструктор бросил исключение). Wait-free
+    T* try_get(size_t index) noexcept {
+        Slot* slot = find_slot(index);
+        if (!slot || slot->state.load(std::memory_order_acquire) != SlotState::Published) {
+            return nullptr;
+        }
+        return slot->value();
+    }
+
+    const T* try_get(size_t index) const noexcept {
+        return const_cast<ConcurrentPmrVector*>(this)->try_get(index);
+    }
+
+    // Доступ по индексу, полученному от push_back/emplace_back (элемент уже опубликован)
+    T& operator[](size_t index) noexcept {
+        auto [segment, offset] = locate(index);
+        return *segments[segment].load(std::memory_order_acquire)[offset].value();
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        auto [segment, offset] = locate(index);
+        return *segments[segment].load(std::memory_order_acquire)[offset].value();
+    }
+
+    T& at(size_t index) {
+        if (T* p = try_get(index)) {
+            return *p;
+        }
+        throw std::out_of_range("element is not published");
+    }
+
+    const T& at(size_t index) const {
+        if (const T* p = try_get(index)) {
+            return *p;
+        }
+        throw std::out_of_range("element is not published");
+    }
+
+    // Обходит опубликованные на момент вызова элементы в порядке индексов
+    template<typename Func>
+    void for_each(Func func) const {
+        size_t count = size();
+        for (size_t i = 0; i < count; ++i) {
+            if (const T* p = try_get(i)) {
+                func(i, *p);
+            }
+        }
+    }
+};
+
+} // namespace my_vector
@@ -0,0 +1,417 @@
+#pragma once
+#include "my_memory_resource.h"
+#include "relocation.h"
+#include <memory_resource>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <algorithm>
+#include <iterator>
+#include <cstring>
+#include <type_traits>
+#include <cstddef>
+#include <new>
+
+namespace my_vector {
+
+// === Динамический массив с непрерывным хранением элементов ===
+// В отличие от PmrVector, где каждый элемент лежит в отдельном блоке, здесь все
+// элементы хранятся подряд в одном буфере polymorphic_allocator<T>. Публичный
+// интерфейс совпадает с PmrVector, но адреса элементов меняются при росте ёмкости,
+// вставке и удалении - если нужна стабильность ссылок, следует использовать PmrVector.
+template<typename T>
+class PmrDenseVector {
+private:
+    using value_allocator_type = std::pmr::polymorphic_allocator<T>;
+    using value_traits = std::allocator_traits<value_allocator_type>;
+
+    T* data_ptr = nullptr;
+    size_t vec_size = 0;
+    size_t vec_capacity = 0;
+
+    value_allocator_type val_alloc;
+
+    // === РАСШИРЕНИЕ ЁМКОСТИ === 
+    // Элементы переносятся в новый буфер (для тривиально перемещаемых T - одним memcpy),
+    // старый буфер освобождается без вызова деструкторов
+    void reallocate(size_t new_cap) {
+        T* new_data = val_alloc.allocate(new_cap);
+        try {
+            relocate_n(val_alloc, data_ptr, vec_size, new_data);
+        } catch (...) {
+            val_alloc.deallocate(new_data, new_cap);
+            throw;
+        }
+
+        if (data_ptr) {
+            val_alloc.deallocate(data_ptr, vec_capacity);
+        }
+        data_ptr = new_data;
+        vec_capacity = new_cap;
+    }
+
+    size_t next_capacity() const noexcept {
+        return (vec_capacity == 0) ? 2 : (vec_capacity * 2);
+    }
+
+    void grow_if_full() {
+        if (vec_size == vec_capacity) {
+            reallocate(next_capacity());
+        }
+    }
+
+    // Рост с созданием нового последнего элемента сразу в новом буфере. Аргументы могут
+    // ссылаться на элементы этого же массива, поэтому старые элементы переносятся только после
+    template<typename... Args>
+    void grow_and_construct_back(Args&&... args) {
+        size_t new_cap = next_capacity();
+        T* new_data = val_alloc.allocate(new_cap);
+        try {
+            value_traits::construct(val_alloc, new_data + vec_size, std::forward<Args>(args)...);
+        } catch (...) {
+            val_alloc.deallocate(new_data, new_cap);
+            throw;
+        }
+        try {
+            relocate_n(val_alloc, data_ptr, vec_size, new_data);
+        } catch (...) {
+            value_traits::destroy(val_alloc, new_data + vec_size);
+            val_alloc.deallocate(new_data, new_cap);
+            throw;
+        }
+
+        if (data_ptr) {
+            val_alloc.deallocate(data_ptr, vec_capacity);
+        }
+        data_ptr = new_data;
+        vec_capacity = new_cap;
+    }
+
+    // Временный элемент, созданный через аллокатор: как и элементы массива, он получает
+    // наш ресурс (например, pmr-строка), а не ресурс по умолчанию
+    class AllocatedTemp {
+    private:
+        value_allocator_type& alloc;
+        alignas(T) std::byte storage[sizeof(T)];
+
+    public:
+        template<typename... Args>
+        explicit AllocatedTemp(value_allocator_type& a, Args&&... args) : alloc(a) {
+            value_traits::construct(alloc, get(), std::forward<Args>(args)...);
+        }
+
+        ~AllocatedTemp() {
+            value_traits::destroy(alloc, get());
+        }
+
+        AllocatedTemp(const AllocatedTemp&) = delete;
+        AllocatedTemp& operator=(const AllocatedTemp&) = delete;
+
+        T* get() noexcept {
+            return std::launder(reinterpret_cast<T*>(storage));
+        }
+    };
+
+    void destroy_range(T* first, T* last) noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (; first != last; ++first) {
+                value_traits::destroy(val_alloc, first);
+            }
+        }
+    }
+
+    // Разрушает элементы и освобождает буфер, не меняя vec_size
+    void release_storage() noexcept {
+        if (data_ptr) {
+            destroy_range(data_ptr, data_ptr + vec_size);
+            val_alloc.deallocate(data_ptr, vec_capacity);
+            data_ptr = nullptr;
+        }
+    }
+
+    void steal(PmrDenseVector& other) noexcept {
+        data_ptr = std::exchange(other.data_ptr, nullptr);
+        vec_size = std::exchange(other.vec_size, 0);
+        vec_capacity = std::exchange(other.vec_capacity, 0);
+    }
+
+    void move_elements_from(PmrDenseVector& other) {
+        reserve(other.vec_size);
+        for (size_t i = 0; i < other.vec_size; ++i) {
+            value_traits::construct(val_alloc, data_ptr + vec_size, std::move(other.data_ptr[i]));
+            ++vec_size;
+        }
+        other.clear();
+    }
+
+public:
+    using Iterator = T*;
+    using ConstIterator = const T*;
+    using ReverseIterator = std::reverse_iterator<Iterator>;
+    using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = Iterator;
+    using const_iterator = ConstIterator;
+    using reverse_iterator = ReverseIterator;
+    using const_reverse_iterator = ConstReverseIterator;
+
+    PmrDenseVector(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) : val_alloc(resource) {}
+
+    ~PmrDenseVector() {
+        release_storage();
+    }
+
+    PmrDenseVector(const PmrDenseVector&) = delete;
+    PmrDenseVector& operator=(const PmrDenseVector&) = delete;
+
+    // Перемещение забирает буфер целиком; при разных ресурсах элементы перемещаются по одному
+    PmrDenseVector(PmrDenseVector&& other) noexcept : val_alloc(other.val_alloc) {
+        steal(other);
+    }
+
+    PmrDenseVector(PmrDenseVector&& other, std::pmr::memory_resource* resource) : val_alloc(resource) {
+        if (val_alloc == other.val_alloc) {
+            steal(other);
+        } else {
+            move_elements_from(other);
+        }
+    }
+
+    PmrDenseVector& operator=(PmrDenseVector&& other) {
+        if (this == &other) {
+            return *this;
+        }
+        release_storage();
+        vec_size = 0;
+        vec_capacity = 0;
+        if (val_alloc == other.val_alloc) {
+            steal(other);
+        } else {
+            move_elements_from(other);
+        }
+        return *this;
+    }
+
+    std::pmr::memory_resource* get_resource() const noexcept {
+        return val_alloc.resource();
+    }
+
+    // === capacity ===
+    size_t size() const noexcept {
+        return vec_size;
+    }
+
+    size_t capacity() const noexcept {
+        return vec_capacity;
+    }
+
+    bool empty() const noexcept {
+        return vec_size == 0;
+    }
+
+    void reserve(size_t new_cap) {
+        if (new_cap > vec_capacity) {
+            reallocate(new_cap);
+        }
+    }
+
+    void shrink_to_fit() {
+        if (vec_size == 0) {
+            release_storage();
+            vec_capacity = 0;
+        } else if (vec_size < vec_capacity) {
+            reallocate(vec_size);
+        }
+    }
+
+    T* data() noexcept {
+        return data_ptr;
+    }
+
+    const T* data() const noexcept {
+        return data_ptr;
+    }
+
+    // === ДОСТУП К ЭЛЕМЕНТУ ===
+    T& operator[](size_t index) {
+        return data_ptr[index];
+    }
+
+    const T& operator[](size_t index) const {
+        return data_ptr[index];
+    }
+
+    T& at(size_t index) {
+        if (index >= vec_size) {
+            throw std::out_of_range("index out of range");
+        }
+        return data_ptr[index];
+    }
+
+    const T& at(size_t index) const {
+        if (index >= vec_size) {
+            throw std::out_of_range("index out of range");
+        }
+        return data_ptr[index];
+    }
+
+    // === МОДИФИКАТОРЫ ===
+    void push_back(const T& value) {
+        emplace_back(value);
+    }
+
+    void push_back(T&& value) {
+        emplace_back(std::move(value));
+    }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (vec_size == vec_capacity) {
+            grow_and_construct_back(std::forward<Args>(args)...);
+        } else {
+            value_traits::construct(val_alloc, data_ptr + vec_size, std::forward<Args>(args)...);
+        }
+        return data_ptr[vec_size++];
+    }
+
+    void pop_back() {
+        if (empty()) {
+            throw std::runtime_error("pop_back from empty vector");
+        }
+        value_traits::destroy(val_alloc, data_ptr + vec_size - 1);
+        --vec_size;
+    }
+
+    void clear() {
+        destroy_range(data_ptr, data_ptr + vec_size);
+        vec_size = 0;
+    }
+
+    // === front/back ===
+    T& front() {
+        if (empty()) {
+            throw std::runtime_error("front() from empty vector");
+        }
+        return data_ptr[0];
+    }
+
+    const T& front() const {
+        if (empty()) {
+            throw std::runtime_error("front() from empty vector");
+        }
+        return data_ptr[0];
+    }
+
+    T& back() {
+        if (empty()) {
+            throw std::runtime_error("back() from empty vector");
+        }
+        return data_ptr[vec_size - 1];
+    }
+
+    const T& back() const {
+        if (empty()) {
+            throw std::runtime_error("back() from empty vector");
+        }
+        return data_ptr[vec_size - 1];
+    }
+
+    // === ВСТАВКА/УДАЛЕНИЕ ПО ИНДЕКСУ ===
+    void insert(size_t index, const T& value) {
+        emplace(index, value);
+    }
+
+    void insert(size_t index, T&& value) {
+        emplace(index, std::move(value));
+    }
+
+    template<typename... Args>
+    T& emplace(size_t index, Args&&... args) {
+        if (index > vec_size) {
+            throw std::out_of_range("insert index out of range");
+        }
+        if (index == vec_size) {
+            return emplace_back(std::forward<Args>(args)...);
+        }
+
+        // аргументы могут ссылаться на сдвигаемые элементы - создаём объект до роста и сдвига
+        AllocatedTemp tmp(val_alloc, std::forward<Args>(args)...);
+        grow_if_full();
+
+        if constexpr (is_trivially_relocatable_v<T> && std::is_nothrow_move_constructible_v<T>) {
+            // хвост сдвигается побайтово, освободившаяся позиция - сырая память
+            std::memmove(static_cast<void*>(data_ptr + index + 1), static_cast<const void*>(data_ptr + index),
+                         (vec_size - index) * sizeof(T));
+            value_traits::construct(val_alloc, data_ptr + index, std::move(*tmp.get()));
+            ++vec_size;
+            return data_ptr[index];
+        } else {
+            // сдвигаем хвост на одну позицию вправо
+            value_traits::construct(val_alloc, data_ptr + vec_size, std::move(data_ptr[vec_size - 1]));
+            ++vec_size;
+            std::move_backward(data_ptr + index, data_ptr + vec_size - 2, data_ptr + vec_size - 1);
+            data_ptr[index] = std::move(*tmp.get());
+            return data_ptr[index];
+        }
+    }
+
+    void erase(size_t index) {
+        if (index >= vec_size) {
+            throw std::out_of_range("erase index out of range");
+        }
+
+        if constexpr (is_trivially_relocatable_v<T>) {
+            value_traits::destroy(val_alloc, data_ptr + index);
+            std::memmove(static_cast<void*>(data_ptr + index), static_cast<const void*>(data_ptr + index + 1),
+                         (vec_size - index - 1) * sizeof(T));
+        } else {
+            std::move(data_ptr + index + 1, data_ptr + vec_size, data_ptr + index);
+            value_traits::destroy(val_alloc, data_ptr + vec_size - 1);
+        }
+        --vec_size;
+    }
+
+    Iterator begin() {
+        return data_ptr;
+    }
+    Iterator end() {
+        return data_ptr + vec_size;
+    }
+    ConstIterator begin() const {
+        return data_ptr;
+    }
+    ConstIterator end() const {
+        return data_ptr + vec_size;
+    }
+    ConstIterator cbegin() const {
+        return begin();
+    }
+    ConstIterator cend() const {
+        return end();
+    }
+
+    ReverseIterator rbegin() {
+        return ReverseIterator(end());
+    }
+    ReverseIterator rend() {
+        return ReverseIterator(begin());
+    }
+    ConstReverseIterator rbegin() const {
+        return ConstReverseIterator(end());
+    }
+    ConstReverseIterator rend() const {
+        return ConstReverseIterator(begin());
+    }
+    ConstReverseIterator crbegin() const {
+        return rbegin();
+    }
+    ConstReverseIterator crend() const {
+        return rend();
+    }
+};
+} // namespace my_vector
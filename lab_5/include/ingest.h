@@ -0,0 +1,394 @@
+#pragma once
+#include "vector.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <istream>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace my_vector {
+
+// === Потоковая загрузка записей в PmrVector с ограниченной памятью ===
+// Поток-производитель читает вход кусками фиксированного размера и разбирает их на
+// записи (для текста - на поля), вызывающий поток забирает готовые пачки из очереди,
+// резервирует место под пачку (с геометрическим ростом) и конструирует элементы прямо в векторе.
+// Всего существует не больше max_batches_in_flight + 2 пачек (очередь плюс по одной у
+// каждой стадии, свободные пачки переиспользуются): если потребитель не успевает,
+// производитель ждёт (backpressure). В пачке не больше chunk_bytes + max_record_bytes
+// байт текста и по sizeof(string_view) + 4 байта на каждое поле и запись в таблицах
+// разбора; буфер незавершённой записи между кусками - ещё не больше одного текста пачки.
+// Запись длиннее max_record_bytes - ошибка, а не рост буфера до размера входа. Память
+// ограничена этими величинами независимо от размера входа; фактический максимум
+// (по ёмкости всех буферов) возвращается в IngestStats::peak_buffered_bytes.
+// Строковые поля передаются как string_view на буфер куска: если T использует
+// polymorphic_allocator (allocator_type), строки выделяются в ресурсе самого вектора.
+
+struct IngestOptions {
+    size_t chunk_bytes = size_t{1} << 20; // размер одного чтения
+    size_t max_batches_in_flight = 4;     // пачек в очереди между стадиями
+    size_t max_record_bytes = size_t{1} << 20; // запись длиннее - ошибка, а не рост буфера
+    char delimiter = ',';                 // разделитель полей (без кавычек и экранирования)
+    char record_separator = '\n';
+    bool skip_header = false;             // пропустить первую строку
+};
+
+struct IngestStats {
+    uint64_t bytes = 0;
+    uint64_t records = 0;
+    uint64_t batches = 0;
+    size_t peak_buffered_bytes = 0; // максимум памяти всех буферов конвейера (ёмкость)
+    double seconds = 0.0;
+
+    double mb_per_second() const noexcept {
+        return seconds > 0.0 ? static_cast<double>(bytes) / 1e6 / seconds : 0.0;
+    }
+};
+
+// Разбор числового поля; некорректное значение - исключение
+template<typename Number>
+Number parse_field(std::string_view field) {
+    Number value{};
+    auto [end, error] = std::from_chars(field.data(), field.data() + field.size(), value);
+    if (error != std::errc() || end != field.data() + field.size()) {
+        throw std::runtime_error("cannot parse field '" + std::string(field) + "'");
+    }
+    return value;
+}
+
+namespace ingest_detail {
+
+// Пачка: буфер куска и разобранные записи, ссылающиеся на него
+struct Batch {
+    std::vector<char> buffer;
+    std::vector<std::string_view> fields;
+    std::vector<uint32_t> field_counts; // число полей каждой записи (для текста)
+    size_t records = 0;
+    size_t accounted = 0; // сколько байт пачки уже учтено очередью
+
+    size_t footprint() const noexcept {
+        return buffer.capacity() + fields.capacity() * sizeof(std::string_view) +
+               field_counts.capacity() * sizeof(uint32_t);
+    }
+};
+
+// Очередь пачек ограниченной ёмкости между производителем и потребителем.
+// Пачек создаётся не больше limit + 2; обработанные возвращаются производителю, чтобы не
+// выделять память на каждый кусок. Очередь же считает память всех пачек и хвоста
+class BatchQueue {
+public:
+    explicit BatchQueue(size_t capacity) : limit(std::max<size_t>(capacity, 1)) {}
+
+    // Свободная пачка для производителя; ждёт, пока потребитель вернёт одну из уже
+    // созданных. false - потребитель отменил загрузку
+    bool acquire(Batch& batch) {
+        std::unique_lock<std::mutex> lock(mutex);
+        not_full.wait(lock, [this] { return cancelled || !spare.empty() || created < limit + 2; });
+        if (cancelled) {
+            return false;
+        }
+        if (spare.empty()) {
+            ++created;
+            batch = Batch{};
+            return true;
+        }
+        batch = std::move(spare.back());
+        spare.pop_back();
+        batch.fields.clear();
+        batch.field_counts.clear();
+        batch.records = 0;
+        return true;
+    }
+
+    // carry_bytes - память незавершённой записи, которую производитель держит у себя.
+    // false - потребитель отменил загрузку
+    bool push(Batch&& batch, size_t carry_bytes = 0) {
+        std::unique_lock<std::mutex> lock(mutex);
+        account(batch, carry_bytes);
+        not_full.wait(lock, [this] { return cancelled || ready.size() < limit; });
+        if (cancelled) {
+            return false;
+        }
+        ready.push_back(std::move(batch));
+        not_empty.notify_one();
+        return true;
+    }
+
+    // false - производитель закончил и очередь пуста
+    bool pop(Batch& batch) {
+        std::unique_lock<std::mutex> lock(mutex);
+        not_empty.wait(lock, [this] { return finished || !ready.empty(); });
+        if (ready.empty()) {
+            return false;
+        }
+        batch = std::move(ready.front());
+        ready.pop_front();
+        not_full.notify_one();
+        return true;
+    }
+
+    // Возврат пачки без данных или после обработки
+    void recycle(Batch&& batch, size_t carry_bytes = 0) {
+        std::lock_guard<std::mutex> lock(mutex);
+        account(batch, carry_bytes);
+        spare.push_back(std::move(batch));
+        not_full.notify_one();
+    }
+
+    void finish(std::exception_ptr producer_error = nullptr) {
+        std::lock_guard<std::mutex> lock(mutex);
+        finished = true;
+        error = producer_error;
+        not_empty.notify_all();
+    }
+
+    void cancel() {
+        std::lock_guard<std::mutex> lock(mutex);
+        cancelled = true;
+        not_full.notify_all();
+    }
+
+    std::exception_ptr producer_error() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return error;
+    }
+
+    size_t peak_bytes() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return peak;
+    }
+
+private:
+    // Вызывается под мьютексом: обновляет вклад пачки и хвоста в общую память
+    void account(Batch& batch, size_t carry_bytes) {
+        size_t now = batch.footprint();
+        resident = resident - batch.accounted + now;
+        batch.accounted = now;
+        carry = carry_bytes;
+        peak = std::max(peak, resident + carry);
+    }
+
+    std::mutex mutex;
+    std::condition_variable not_full;
+    std::condition_variable not_empty;
+    std::deque<Batch> ready;
+    std::vector<Batch> spare;
+    size_t limit;
+    size_t created = 0;
+    size_t resident = 0; // память всех созданных пачек
+    size_t carry = 0;
+    size_t peak = 0;
+    bool finished = false;
+    bool cancelled = false;
+    std::exception_ptr error;
+};
+
+// Запускает производителя produce(queue) в отдельном потоке (возвращает число прочитанных байт),
+// потребляет пачки consume(batch) в вызывающем. Исключение любой стороны останавливает обе и пробрасывается вызывающему
+template<typename Produce, typename Consume>
+IngestStats run_pipeline(const IngestOptions& options, Produce produce, Consume consume) {
+    BatchQueue queue(options.max_batches_in_flight);
+    IngestStats stats;
+    uint64_t bytes_read = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    std::thread producer([&] {
+        try {
+            bytes_read = produce(queue);
+            queue.finish();
+        } catch (...) {
+            queue.finish(std::current_exception());
+        }
+    });
+
+    try {
+        Batch batch;
+        while (queue.pop(batch)) {
+            consume(batch);
+            stats.records += batch.records;
+            ++stats.batches;
+            queue.recycle(std::move(batch));
+        }
+    } catch (...) {
+        queue.cancel();
+        producer.join();
+        throw;
+    }
+    producer.join();
+    if (std::exception_ptr error = queue.producer_error()) {
+        std::rethrow_exception(error);
+    }
+
+    stats.bytes = bytes_read;
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    stats.peak_buffered_bytes = queue.peak_bytes();
+    return stats;
+}
+
+// reserve у PmrVector точный: ёмкость растёт геометрически, иначе каждая пачка
+// копировала бы всю таблицу указателей и загрузка мелкими кусками стала бы квадратичной
+template<typename T, size_t N>
+void reserve_batch(PmrVector<T, N>& vec, size_t records) {
+    size_t needed = vec.size() + records;
+    if (needed > vec.capacity()) {
+        vec.reserve(std::max(needed, 2 * vec.capacity()));
+    }
+}
+
+// Читает до chunk_bytes байт в конец буфера; возвращает число прочитанных
+inline size_t read_some(std::istream& in, std::vector<char>& buffer, size_t offset, size_t chunk_bytes) {
+    buffer.resize(offset + chunk_bytes);
+    in.read(buffer.data() + offset, static_cast<std::streamsize>(chunk_bytes));
+    size_t got = static_cast<size_t>(in.gcount());
+    buffer.resize(offset + got);
+    if (in.bad()) {
+        throw std::runtime_error("ingest: read failed");
+    }
+    return got;
+}
+
+} // namespace ingest_detail
+
+// Загрузка текстовых записей с разделителями. emplace(vec, fields) вызывается для каждой
+// записи (fields - string_view на поля, действительны только во время вызова) и должна
+// добавить элемент, например vec.emplace_back(fields[0], parse_field<int>(fields[1])).
+// Место резервируется один раз на пачку. Пустые строки пропускаются.
+template<typename T, size_t N, typename Emplace>
+IngestStats ingest_delimited(std::istream& in, PmrVector<T, N>& vec, Emplace emplace, const IngestOptions& options = {}) {
+    using ingest_detail::Batch;
+    bool header_pending = options.skip_header;
+
+    auto produce = [&](ingest_detail::BatchQueue& queue) -> uint64_t {
+        std::vector<char> carry; // незавершённая запись с конца предыдущего куска
+        uint64_t bytes = 0;
+        bool eof = false;
+        Batch batch;
+        while (!eof && queue.acquire(batch)) {
+            batch.buffer.swap(carry);
+            size_t carried = batch.buffer.size();
+            size_t got = ingest_detail::read_some(in, batch.buffer, carried, options.chunk_bytes);
+            bytes += got;
+            eof = got == 0 || in.eof();
+
+            // кусок обрезается по последнему разделителю записей, остаток уходит в следующий
+            std::string_view text(batch.buffer.data(), batch.buffer.size());
+            size_t end = eof ? text.size() : text.rfind(options.record_separator);
+            size_t tail = end == std::string_view::npos ? 0 : (eof ? text.size() : end + 1);
+            if (text.size() - tail > options.max_record_bytes) {
+                throw std::runtime_error("ingest: record exceeds max_record_bytes");
+            }
+            if (tail == 0 && !eof) {
+                carry.swap(batch.buffer); // запись длиннее куска - читаем дальше
+                queue.recycle(std::move(batch), carry.capacity());
+                continue;
+            }
+            carry.assign(batch.buffer.begin() + static_cast<std::ptrdiff_t>(tail), batch.buffer.end());
+
+            size_t pos = 0;
+            while (pos < tail) {
+                size_t line_end = std::min(text.find(options.record_separator, pos), tail);
+                std::string_view line = text.substr(pos, line_end - pos);
+                pos = line_end + 1;
+                if (!line.empty() && line.back() == '\r') {
+                    line.remove_suffix(1);
+                }
+                if (line.empty()) {
+                    continue;
+                }
+                if (line.size() > options.max_record_bytes) {
+                    throw std::runtime_error("ingest: record exceeds max_record_bytes");
+                }
+                if (header_pending) {
+                    header_pending = false;
+                    continue;
+                }
+                uint32_t count = 0;
+                size_t field_start = 0;
+                while (true) {
+                    size_t field_end = line.find(options.delimiter, field_start);
+                    batch.fields.push_back(line.substr(field_start, field_end - field_start));
+                    ++count;
+                    if (field_end == std::string_view::npos) {
+                        break;
+                    }
+                    field_start = field_end + 1;
+                }
+                batch.field_counts.push_back(count);
+                ++batch.records;
+            }
+            batch.buffer.resize(tail); // хвост уже скопирован в carry
+            if (batch.records == 0) {
+                queue.recycle(std::move(batch), carry.capacity());
+            } else if (!queue.push(std::move(batch), carry.capacity())) {
+                break;
+            }
+        }
+        return bytes;
+    };
+
+    auto consume = [&](Batch& batch) {
+        ingest_detail::reserve_batch(vec, batch.records);
+        size_t next = 0;
+        for (uint32_t count : batch.field_counts) {
+            emplace(vec, std::span<const std::string_view>(batch.fields.data() + next, count));
+            next += count;
+        }
+    };
+
+    return ingest_detail::run_pipeline(options, produce, consume);
+}
+
+// Загрузка двоичного файла из подряд записанных тривиально копируемых T
+// (например, результата save() без заголовка или дампа массива структур)
+template<typename T, size_t N>
+IngestStats ingest_binary(std::istream& in, PmrVector<T, N>& vec, const IngestOptions& options = {}) {
+    static_assert(std::is_trivially_copyable_v<T>, "binary ingestion requires trivially copyable records");
+    using ingest_detail::Batch;
+    const size_t chunk = std::max<size_t>(options.chunk_bytes / sizeof(T), 1) * sizeof(T);
+
+    auto produce = [&](ingest_detail::BatchQueue& queue) -> uint64_t {
+        uint64_t bytes = 0;
+        Batch batch;
+        while (queue.acquire(batch)) {
+            size_t got = ingest_detail::read_some(in, batch.buffer, 0, chunk);
+            if (got % sizeof(T) != 0) {
+                throw std::runtime_error("ingest: binary input ends with a partial record");
+            }
+            bytes += got;
+            batch.records = got / sizeof(T);
+            if (batch.records == 0) {
+                queue.recycle(std::move(batch));
+                break;
+            }
+            if (!queue.push(std::move(batch))) {
+                break;
+            }
+        }
+        return bytes;
+    };
+
+    auto consume = [&](Batch& batch) {
+        ingest_detail::reserve_batch(vec, batch.records);
+        for (size_t i = 0; i < batch.records; ++i) {
+            T value;
+            std::memcpy(static_cast<void*>(&value), batch.buffer.data() + i * sizeof(T), sizeof(T));
+            vec.push_back(value);
+        }
+    };
+
+    return ingest_detail::run_pipeline(options, produce, consume);
+}
+
+} // namespace my_vector
@@ -0,0 +1,99 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace my_vector {
+
+// === Встроенный буфер PmrVector<T, N> ===
+// Хранит внутри объекта вектора таблицу из N указателей и N слотов под элементы.
+// Пока вектор не вырос больше N, он не обращается к memory_resource вовсе.
+// Занятость слотов - битовая маска, поэтому N ограничено 64.
+template<typename T, size_t N>
+class InlineStorage {
+    static_assert(N <= 64, "inline capacity is limited to 64 elements");
+
+private:
+    T* table[N];
+    alignas(T) std::byte storage[N * sizeof(T)];
+    uint64_t used = 0;
+
+    static constexpr uint64_t kFull = (N == 64) ? ~uint64_t{0} : ((uint64_t{1} << N) - 1);
+
+public:
+    InlineStorage() = default;
+    InlineStorage(const InlineStorage&) = delete;
+    InlineStorage& operator=(const InlineStorage&) = delete;
+
+    T** table_data() noexcept {
+        return table;
+    }
+
+    bool owns_table(T* const* p) const noexcept {
+        return p == table;
+    }
+
+    T* slot(size_t index) noexcept {
+        return reinterpret_cast<T*>(storage + index * sizeof(T));
+    }
+
+    bool owns(const T* p) const noexcept {
+        auto* bytes = reinterpret_cast<const std::byte*>(p);
+        return !std::less<const std::byte*>()(bytes, storage) && std::less<const std::byte*>()(bytes, storage + sizeof(storage));
+    }
+
+    size_t index_of(const T* p) const noexcept {
+        return static_cast<size_t>(reinterpret_cast<const std::byte*>(p) - storage) / sizeof(T);
+    }
+
+    size_t free_count() const noexcept {
+        return N - static_cast<size_t>(std::popcount(used));
+    }
+
+    // Свободный встроенный слот или nullptr, если все заняты
+    T* allocate() noexcept {
+        if (used == kFull) {
+            return nullptr;
+        }
+        size_t index = static_cast<size_t>(std::countr_one(used));
+        used |= uint64_t{1} << index;
+        return slot(index);
+    }
+
+    // Занимает конкретный слот (при переносе элементов из другого вектора)
+    void mark_used(size_t index) noexcept {
+        used |= uint64_t{1} << index;
+    }
+
+    // false - указатель не из встроенного буфера, его нужно вернуть в пул
+    bool deallocate(T* p) noexcept {
+        if (!owns(p)) {
+            return false;
+        }
+        used &= ~(uint64_t{1} << index_of(p));
+        return true;
+    }
+
+    void reset() noexcept {
+        used = 0;
+    }
+};
+
+// Без встроенной ёмкости буфер пуст и не занимает места в объекте
+template<typename T>
+class InlineStorage<T, 0> {
+public:
+    T** table_data() noexcept { return nullptr; }
+    bool owns_table(T* const*) const noexcept { return false; }
+    T* slot(size_t) noexcept { return nullptr; }
+    bool owns(const T*) const noexcept { return false; }
+    size_t index_of(const T*) const noexcept { return 0; }
+    size_t free_count() const noexcept { return 0; }
+    T* allocate() noexcept { return nullptr; }
+    void mark_used(size_t) noexcept {}
+    bool deallocate(T*) noexcept { return false; }
+    void reset() noexcept {}
+};
+
+} // namespace my_vector
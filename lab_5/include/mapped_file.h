@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+namespace my_vector {
+
+// === Файл, отображённый в память (POSIX mmap) ===
+// Отображение MAP_SHARED: изменения попадают в файл и переживают перезапуск процесса.
+// При resize() файл дорастает/укорачивается, а отображение пересоздаётся - адрес data() может измениться.
+class MappedFile {
+public:
+    // Открывает (или создаёт) файл и отображает его целиком
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    std::byte* data() const noexcept {
+        return mapping;
+    }
+
+    size_t size() const noexcept {
+        return mapped_size;
+    }
+
+    const std::string& path() const noexcept {
+        return file_path;
+    }
+
+    void resize(size_t new_size);
+
+    // Сбрасывает изменённые страницы на диск
+    void sync();
+
+private:
+    std::string file_path;
+    int fd = -1;
+    std::byte* mapping = nullptr;
+    size_t mapped_size = 0;
+
+    void map(size_t size);
+    void unmap() noexcept;
+};
+
+} // namespace my_vector
@@ -1,31 +1,175 @@
 #pragma once
+#include "alloc_trace.h"
 #include <memory_resource>
 #include <list>
+#include <array>
+#include <vector>
+#include <unordered_map>
 #include <cstddef>
+#include <cstdint>
 #include <new>
 
 namespace my_vector {
 
+struct BlockInfo;
+using BlockList = std::list<BlockInfo>;
+
 struct BlockInfo {
     void* ptr;
     size_t size;
     size_t alignment; // выравнивание
     bool is_allocated; 
+    bool ever_used = false;          // блок (или его часть) уже выдавался - для трассировки reuse
+    size_t chunk = 0;                // номер куска памяти, из которого нарезан блок
+    BlockList::iterator self{};      // позиция в списке blocks - для слияния соседей
+    BlockInfo* next_free = nullptr;  // интрузивный двусвязный список свободных блоков одного size-класса
+    BlockInfo* prev_free = nullptr;
+};
+
+// Параметры ListMemoryResource
+struct ListMemoryResourceOptions {
+    // Откуда брать куски памяти; nullptr - std::pmr::get_default_resource()
+    std::pmr::memory_resource* upstream = nullptr;
+    // Размер обычного куска, запрошенного у upstream
+    size_t chunk_size = 64 * 1024;
+    // Арена, резервируемая в конструкторе (0 - без арены). Первые аллокации
+    // обслуживаются из неё без обращений к upstream; trim() её не возвращает
+    size_t arena_bytes = 0;
+    // Взять арену через mmap вместо upstream (только POSIX)
+    bool arena_mmap = false;
+    // Попросить у ядра прозрачные huge pages для mmap-арены (MADV_HUGEPAGE, Linux)
+    bool arena_huge_pages = false;
 };
 
+// Профиль ёмкости: сколько блоков каждого размера нужно держать наготове
+struct CapacityProfileEntry {
+    size_t bytes;
+    size_t count;
+};
+using CapacityProfile = std::vector<CapacityProfileEntry>;
+
 // === 1. Наследование от std::pmr::memory_resource ===
+// Память берётся у upstream-ресурса крупными кусками, из которых нарезаются блоки.
+// Блоки одного куска лежат в std::list подряд в порядке адресов, поэтому соседи по
+// списку - соседи в памяти: освобождённый блок сливается со свободными соседями,
+// а слишком большой свободный блок при выдаче расщепляется.
 class ListMemoryResource : public std::pmr::memory_resource {
 public:
-    ListMemoryResource() = default;
+    ListMemoryResource() : ListMemoryResource(ListMemoryResourceOptions{}) {}
+    explicit ListMemoryResource(std::pmr::memory_resource* upstream);
+    explicit ListMemoryResource(const ListMemoryResourceOptions& options);
     ~ListMemoryResource();
 
+    std::pmr::memory_resource* upstream_resource() const noexcept {
+        return upstream;
+    }
+
     ListMemoryResource(const ListMemoryResource&) = delete;
     ListMemoryResource& operator=(const ListMemoryResource&) = delete;
 
+    // Подключение буфера трассировки (nullptr - отключить).
+    // События пишутся только в сборке с MY_VECTOR_ALLOC_TRACE
+    void set_trace(AllocTrace* sink) noexcept {
+        trace = sink;
+    }
+
+    // === Прогрев ===
+    // Заранее нарезает свободные блоки по профилю (из арены, если она есть), чтобы
+    // первые аллокации этих размеров не обращались к upstream и не расщепляли блоки
+    void warm_up(const CapacityProfile& profile);
+
+    // Текущий профиль занятых блоков - его можно сохранить и передать в warm_up при старте
+    CapacityProfile capacity_profile() const;
+
+    // === Возврат памяти системе ===
+    // Освобождает все куски памяти, в том числе занятые блоки - как release()
+    // у std::pmr-ресурсов. Арена не возвращается, а снова становится одним свободным блоком.
+    // Вызывать только когда выданной памятью больше никто не пользуется
+    void release() noexcept;
+
+    // Возвращает системе полностью свободные куски (начиная с давно не использовавшихся),
+    // пока свободной памяти больше max_retained_bytes. Возвращает число освобождённых байт
+    size_t trim(size_t max_retained_bytes) noexcept;
+
+    // Политика верхней границы: после deallocate, если свободной памяти больше limit,
+    // автоматически выполняется trim(limit). По умолчанию выключена
+    void set_retention_limit(size_t limit) noexcept {
+        retention_limit = limit;
+    }
+
+    // === Метрики для мониторинга ===
+    size_t free_bytes() const noexcept {
+        return free_total;
+    }
+
+    size_t reserved_bytes() const noexcept {
+        return reserved_total;
+    }
+
+    size_t largest_free_block() const noexcept;
+
+    // Фрагментация: 1 - (крупнейший свободный блок / все свободные байты).
+    // 0 - вся свободная память одним куском, ближе к 1 - раздроблена на мелкие блоки
+    double fragmentation() const noexcept;
+
 private:
+    // Size-классы - степени двойки: в корзине k лежат свободные блоки размером [2^k, 2^(k+1))
+    static constexpr size_t kSizeClasses = 64;
+    static constexpr size_t kGranularity = alignof(std::max_align_t); // шаг размеров и базовое выравнивание
+    static constexpr size_t kMinSplit = 32;      // меньший остаток не отделяется от блока
+    static constexpr size_t kBestFitScan = 16;   // сколько блоков своей корзины просматривать в поисках лучшего
+
+    enum class ChunkKind : uint8_t {
+        Upstream,     // обычный кусок от upstream
+        Arena,        // арена от upstream
+        MappedArena   // арена через mmap
+    };
+
+    struct ChunkInfo {
+        void* ptr;           // nullptr - кусок возвращён системе, запись можно переиспользовать
+        size_t size;
+        uint64_t last_free;  // "время" последнего освобождения блока в куске
+        size_t alignment = 0;
+        ChunkKind kind = ChunkKind::Upstream;
+        size_t allocated_blocks = 0; // 0 - кусок свободен целиком, даже если нарезан на блоки
+        BlockInfo* head = nullptr;   // первый блок куска (при слиянии не удаляется)
+    };
+
+    std::pmr::memory_resource* upstream;
+    size_t chunk_size;
+
     // Для каждого объекта выделяется блок памяти на куче
     // информация о выделенных блоках хранится в std::list
-    std::list<BlockInfo> blocks;
+    BlockList blocks;
+    std::vector<ChunkInfo> chunks;
+
+    // Голова интрузивного списка каждой корзины,
+    // бит k в nonempty_bins выставлен, если корзина k не пуста
+    std::array<BlockInfo*, kSizeClasses> free_bins{};
+    uint64_t nonempty_bins = 0;
+
+    // Индекс указатель -> выданный блок, чтобы do_deallocate работал за O(1)
+    std::unordered_map<void*, BlockInfo*> index;
+
+    size_t free_total = 0;
+    size_t reserved_total = 0;
+    size_t retention_limit = SIZE_MAX;
+    uint64_t free_tick = 0;
+
+    AllocTrace* trace = nullptr;
+
+    static size_t bin_of(size_t size) noexcept;
+    static size_t padding_for(const BlockInfo& block, size_t alignment) noexcept;
+
+    void push_free(BlockInfo* block) noexcept;
+    void unlink_free(BlockInfo* block) noexcept;
+    BlockInfo* find_fit(size_t bytes, size_t alignment) noexcept;
+    BlockInfo* add_chunk(size_t bytes, size_t alignment);
+    BlockInfo* register_chunk(void* ptr, size_t size, size_t alignment, ChunkKind kind);
+    void reserve_arena(const ListMemoryResourceOptions& options);
+    void free_chunk(const ChunkInfo& chunk) noexcept;
+    BlockInfo* split(BlockInfo* block, size_t offset);
+    BlockInfo* coalesce(BlockInfo* block) noexcept;
 
     void* do_allocate(size_t bytes, size_t alignment) override;
     void do_deallocate(void* p, size_t bytes, size_t alignment) override;
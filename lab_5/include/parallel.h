@@ -0,0 +1,140 @@
+#pragma once
+#include "thread_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <ranges>
+#include <stdexcept>
+
+namespace my_vector::parallel {
+
+// === Параллельные алгоритмы над контейнерами с произвольным доступом ===
+// Диапазон индексов рекурсивно делится пополам: правая половина отдаётся в пул,
+// левая обрабатывается дальше тем же потоком, пока кусок не станет меньше grain.
+// Для PmrVector итераторы идут прямо по таблице указателей, элементы не копируются.
+// Первое исключение из тела прерывает выдачу новых кусков и пробрасывается вызывающему.
+
+namespace detail {
+
+inline size_t default_grain(const ThreadPool& pool, size_t count) {
+    // ~8 кусков на поток: хватает для балансировки, накладные расходы малы
+    return std::max<size_t>(1024, count / (8 * (pool.size() + 1)));
+}
+
+// body(begin, end) вызывается для непересекающихся полуинтервалов, покрывающих [0, count)
+template<typename Body>
+void parallel_for(ThreadPool& pool, size_t count, size_t grain, const Body& body) {
+    if (count == 0) {
+        return;
+    }
+    grain = std::max<size_t>(grain, 1);
+
+    std::atomic<size_t> remaining{count};
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    std::function<void(size_t, size_t)> run = [&](size_t begin, size_t end) {
+        while (end - begin > grain && !failed.load(std::memory_order_relaxed)) {
+            size_t mid = begin + (end - begin) / 2;
+            pool.spawn([&run, mid, end] { run(mid, end); });
+            end = mid;
+        }
+        if (!failed.load(std::memory_order_relaxed)) {
+            try {
+                body(begin, end);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                failed.store(true, std::memory_order_relaxed);
+            }
+        }
+        // после этой строки вызывающий поток может выйти - к локальным данным больше не обращаемся
+        remaining.fetch_sub(end - begin, std::memory_order_acq_rel);
+    };
+
+    run(0, count);
+    pool.help_while([&] { return remaining.load(std::memory_order_acquire) != 0; });
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace detail
+
+// func(element) для каждого элемента
+template<std::ranges::random_access_range Range, typename Func>
+void for_each(ThreadPool& pool, Range&& range, Func func, size_t grain = 0) {
+    auto first = std::ranges::begin(range);
+    size_t count = static_cast<size_t>(std::ranges::distance(range));
+    detail::parallel_for(pool, count, grain ? grain : detail::default_grain(pool, count),
+                         [&](size_t begin, size_t end) {
+                             for (auto it = first + begin, last = first + end; it != last; ++it) {
+                                 func(*it);
+                             }
+                         });
+}
+
+// out[i] = func(in[i]); элементы out должны уже существовать (например, после out.resize(in.size())),
+// потому что создавать элементы PmrVector из нескольких потоков нельзя
+template<std::ranges::random_access_range In, std::ranges::random_access_range Out, typename Func>
+void transform(ThreadPool& pool, const In& in, Out& out, Func func, size_t grain = 0) {
+    size_t count = static_cast<size_t>(std::ranges::distance(in));
+    if (static_cast<size_t>(std::ranges::distance(out)) < count) {
+        throw std::out_of_range("transform: output range is shorter than input");
+    }
+    auto src = std::ranges::begin(in);
+    auto dst = std::ranges::begin(out);
+    detail::parallel_for(pool, count, grain ? grain : detail::default_grain(pool, count),
+                         [&](size_t begin, size_t end) {
+                             auto out_it = dst + begin;
+                             for (auto it = src + begin, last = src + end; it != last; ++it, ++out_it) {
+                                 *out_it = func(*it);
+                             }
+                         });
+}
+
+// Свёртка proj(element) операцией op; op должна быть ассоциативной и коммутативной,
+// порядок объединения частичных результатов не определён
+template<std::ranges::random_access_range Range, typename Value, typename Op = std::plus<>,
+         typename Proj = std::identity>
+Value reduce(ThreadPool& pool, const Range& range, Value init, Op op = {}, Proj proj = {}, size_t grain = 0) {
+    auto first = std::ranges::begin(range);
+    size_t count = static_cast<size_t>(std::ranges::distance(range));
+    std::mutex result_mutex;
+    detail::parallel_for(pool, count, grain ? grain : detail::default_grain(pool, count),
+                         [&](size_t begin, size_t end) {
+                             auto it = first + begin;
+                             Value partial = std::invoke(proj, *it);
+                             for (++it; it != first + end; ++it) {
+                                 partial = op(std::move(partial), std::invoke(proj, *it));
+                             }
+                             std::lock_guard<std::mutex> lock(result_mutex);
+                             init = op(std::move(init), std::move(partial));
+                         });
+    return init;
+}
+
+template<std::ranges::random_access_range Range, typename Predicate>
+size_t count_if(ThreadPool& pool, const Range& range, Predicate pred, size_t grain = 0) {
+    auto first = std::ranges::begin(range);
+    size_t count = static_cast<size_t>(std::ranges::distance(range));
+    std::atomic<size_t> total{0};
+    detail::parallel_for(pool, count, grain ? grain : detail::default_grain(pool, count),
+                         [&](size_t begin, size_t end) {
+                             size_t local = 0;
+                             for (auto it = first + begin, last = first + end; it != last; ++it) {
+                                 local += pred(*it) ? 1 : 0;
+                             }
+                             total.fetch_add(local, std::memory_order_relaxed);
+                         });
+    return total.load();
+}
+
+} // namespace my_vector::parallel
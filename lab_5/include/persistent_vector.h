@@ -0,0 +1,213 @@
+#pragma once
+#include "mapped_file.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <algorithm>
+
+namespace my_vector {
+
+// === Динамический массив в файле, отображённом в память ===
+// Раскладка не содержит указателей: заголовок в начале файла и элементы по
+// фиксированному смещению. Поэтому файл можно открыть заново в другом процессе
+// по любому адресу за O(1) - без чтения и копирования элементов.
+// Подходит только для тривиально копируемых T.
+template<typename T>
+class PersistentVector {
+    static_assert(std::is_trivially_copyable_v<T>, "PersistentVector requires a trivially copyable type");
+    // данные начинаются на границе 64 байт от начала отображения (оно выровнено по странице)
+    static_assert(alignof(T) <= 64, "PersistentVector supports element alignment up to 64 bytes");
+
+private:
+    struct Header {
+        uint64_t magic;
+        uint32_t version;
+        uint32_t element_size;
+        uint64_t element_alignment;
+        uint64_t size;
+        uint64_t capacity;
+    };
+
+    static constexpr uint64_t kMagic = 0x524F5456504D5950ull; // "PYMPVTOR"
+    static constexpr uint32_t kVersion = 1;
+    static constexpr size_t kDataOffset = (sizeof(Header) + alignof(T) + 63) / 64 * 64;
+
+    MappedFile file;
+
+    Header& header() const noexcept {
+        return *reinterpret_cast<Header*>(file.data());
+    }
+
+    T* elements() const noexcept {
+        return reinterpret_cast<T*>(file.data() + kDataOffset);
+    }
+
+    void format(size_t capacity) {
+        file.resize(kDataOffset + capacity * sizeof(T));
+        header() = Header{kMagic, kVersion, sizeof(T), alignof(T), 0, capacity};
+    }
+
+    // Проверка заголовка и восстановление после усечения файла: если файл короче,
+    // чем заявлено в заголовке, сохраняются только элементы, целиком уместившиеся в файл
+    void open_existing() {
+        Header& h = header();
+        if (h.magic != kMagic || h.version != kVersion) {
+            throw std::runtime_error("not a PersistentVector file: " + file.path());
+        }
+        if (h.element_size != sizeof(T) || h.element_alignment != alignof(T)) {
+            throw std::runtime_error("PersistentVector element type mismatch: " + file.path());
+        }
+
+        size_t fits = (file.size() - kDataOffset) / sizeof(T);
+        if (h.capacity > fits || h.size > h.capacity) {
+            h.capacity = std::min<uint64_t>(h.capacity, fits);
+            h.size = std::min(h.size, h.capacity);
+        }
+        // хвост неполного элемента отрезаем, чтобы размер файла снова совпадал с capacity
+        file.resize(kDataOffset + h.capacity * sizeof(T));
+    }
+
+    // Файл короче заголовка начинается с (части) нашей сигнатуры - чужие данные не затираем
+    bool is_truncated_header() const noexcept {
+        size_t prefix = std::min(file.size(), sizeof(kMagic));
+        return prefix == 0 || std::memcmp(file.data(), &kMagic, prefix) == 0;
+    }
+
+    void grow_if_full() {
+        if (header().size == header().capacity) {
+            reserve(header().capacity == 0 ? 16 : header().capacity * 2);
+        }
+    }
+
+public:
+    using Iterator = T*;
+    using ConstIterator = const T*;
+    using value_type = T;
+
+    // Открывает существующий файл или создаёт новый пустой вектор
+    explicit PersistentVector(const std::string& path) : file(path) {
+        if (file.size() >= kDataOffset) {
+            open_existing();
+        } else if (is_truncated_header()) {
+            // пустой файл или наш, обрезанный внутри заголовка (элементов в нём нет) - начинаем заново
+            format(0);
+        } else {
+            throw std::runtime_error("not a PersistentVector file: " + file.path());
+        }
+    }
+
+    PersistentVector(const PersistentVector&) = delete;
+    PersistentVector& operator=(const PersistentVector&) = delete;
+
+    // === capacity ===
+    size_t size() const noexcept {
+        return header().size;
+    }
+
+    size_t capacity() const noexcept {
+        return header().capacity;
+    }
+
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    // Рост - через увеличение файла и повторное отображение: адреса элементов меняются
+    void reserve(size_t new_cap) {
+        if (new_cap > capacity()) {
+            file.resize(kDataOffset + new_cap * sizeof(T));
+            header().capacity = new_cap;
+        }
+    }
+
+    // Укорачивает файл до текущего размера
+    void shrink_to_fit() {
+        file.resize(kDataOffset + size() * sizeof(T));
+        header().capacity = size();
+    }
+
+    // === ДОСТУП К ЭЛЕМЕНТУ ===
+    T& operator[](size_t index) {
+        return elements()[index];
+    }
+
+    const T& operator[](size_t index) const {
+        return elements()[index];
+    }
+
+    T& at(size_t index) {
+        if (index >= size()) {
+            throw std::out_of_range("index out of range");
+        }
+        return elements()[index];
+    }
+
+    const T& at(size_t index) const {
+        if (index >= size()) {
+            throw std::out_of_range("index out of range");
+        }
+        return elements()[index];
+    }
+
+    T& front() {
+        if (empty()) {
+            throw std::runtime_error("front() from empty vector");
+        }
+        return elements()[0];
+    }
+
+    T& back() {
+        if (empty()) {
+            throw std::runtime_error("back() from empty vector");
+        }
+        return elements()[size() - 1];
+    }
+
+    T* data() noexcept {
+        return elements();
+    }
+
+    // === МОДИФИКАТОРЫ ===
+    // Элемент записывается раньше, чем увеличивается size в заголовке: после сбоя
+    // в файле не окажется элемента, который учтён в размере, но не записан
+    void push_back(const T& value) {
+        T copy = value;
+        grow_if_full();
+        elements()[size()] = copy;
+        ++header().size;
+    }
+
+    void pop_back() {
+        if (empty()) {
+            throw std::runtime_error("pop_back from empty vector");
+        }
+        --header().size;
+    }
+
+    void clear() noexcept {
+        header().size = 0;
+    }
+
+    // Гарантирует, что данные записаны на диск
+    void sync() {
+        file.sync();
+    }
+
+    Iterator begin() {
+        return elements();
+    }
+    Iterator end() {
+        return elements() + size();
+    }
+    ConstIterator begin() const {
+        return elements();
+    }
+    ConstIterator end() const {
+        return elements() + size();
+    }
+};
+
+} // namespace my_vector
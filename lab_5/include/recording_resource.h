@@ -0,0 +1,86 @@
+#pragma once
+#include <memory_resource>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace my_vector {
+
+// === Запись и воспроизведение последовательности аллокаций ===
+
+// Одна операция трассы: выделение (размер, выравнивание) или освобождение по номеру выделения.
+// Номер выделения - его порядковый номер среди всех Allocate в трассе
+struct AllocRecord {
+    enum class Kind : uint8_t { Allocate, Deallocate };
+
+    Kind kind;
+    uint64_t size_or_id; // Allocate - размер в байтах, Deallocate - номер выделения
+    uint32_t alignment;  // только для Allocate
+};
+
+// Формат файла: заголовок (магия, версия, число записей), затем записи в виде LEB128:
+// Allocate - (size << 1), байт log2(alignment); Deallocate - (id << 1) | 1.
+// Типичная запись занимает 2-4 байта
+struct AllocationTrace {
+    std::vector<AllocRecord> records;
+    uint64_t allocation_count = 0;
+
+    void write(std::ostream& os) const;
+    void write(const std::string& path) const;
+
+    static AllocationTrace read(std::istream& is);
+    static AllocationTrace read(const std::string& path);
+};
+
+// Декоратор над memory_resource: пересылает вызовы upstream и записывает их в трассу.
+// Потокобезопасен, если потокобезопасен upstream (запись трассы - под мьютексом)
+class RecordingResource : public std::pmr::memory_resource {
+public:
+    explicit RecordingResource(std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+
+    RecordingResource(const RecordingResource&) = delete;
+    RecordingResource& operator=(const RecordingResource&) = delete;
+
+    std::pmr::memory_resource* upstream_resource() const noexcept {
+        return upstream;
+    }
+
+    // Копия записанной на данный момент трассы
+    AllocationTrace trace() const;
+
+    void save(const std::string& path) const;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    std::pmr::memory_resource* upstream;
+
+    mutable std::mutex mutex;
+    AllocationTrace recorded;
+    std::unordered_map<void*, uint64_t> live; // адрес -> номер выделения
+};
+
+struct ReplayResult {
+    uint64_t operations = 0;
+    uint64_t bytes_allocated = 0;
+    double seconds = 0.0;
+    double reuse_rate = 0.0;  // доля выделений, получивших ранее освобождённый адрес
+    uint64_t leaked = 0;      // выделения без парного освобождения (освобождаются после замера)
+
+    double ops_per_second() const noexcept {
+        return seconds > 0.0 ? static_cast<double>(operations) / seconds : 0.0;
+    }
+};
+
+// Повторяет трассу на ресурсе resource в том же порядке. Блоки, не освобождённые
+// в трассе, освобождаются после замера времени
+ReplayResult replay(const AllocationTrace& trace, std::pmr::memory_resource* resource);
+
+} // namespace my_vector
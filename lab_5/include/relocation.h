@@ -0,0 +1,48 @@
+#pragma once
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+namespace my_vector {
+
+// === Тривиальная перемещаемость ===
+// Объект можно перенести на новое место побайтовым копированием, не вызывая
+// перемещающий конструктор и деструктор старой копии. По умолчанию так считаются
+// тривиально копируемые типы; свой тип, который не хранит указателей на самого себя
+// (например, обёртку над unique_ptr), можно отметить специализацией:
+//     template<> struct my_vector::is_trivially_relocatable<MyType> : std::true_type {};
+// std::string сюда не относится: в libstdc++ короткая строка указывает на собственный буфер.
+template<typename T>
+struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>> {};
+
+template<typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+// Переносит count объектов из src в неинициализированную память dst (области не пересекаются);
+// после вызова объекты в src считаются уничтоженными
+template<typename T, typename Alloc>
+void relocate_n(Alloc& alloc, T* src, size_t count, T* dst) {
+    if constexpr (is_trivially_relocatable_v<T>) {
+        if (count) {
+            std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), count * sizeof(T));
+        }
+    } else {
+        using traits = std::allocator_traits<Alloc>;
+        size_t done = 0;
+        try {
+            for (; done < count; ++done) {
+                traits::construct(alloc, dst + done, std::move_if_noexcept(src[done]));
+            }
+        } catch (...) {
+            for (size_t i = 0; i < done; ++i) {
+                traits::destroy(alloc, dst + i);
+            }
+            throw;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            traits::destroy(alloc, src + i);
+        }
+    }
+}
+
+} // namespace my_vector
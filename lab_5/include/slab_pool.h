@@ -0,0 +1,233 @@
+#pragma once
+#include <memory_resource>
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <functional>
+#include <vector>
+
+namespace my_vector {
+
+// === Пул слотов под элементы PmrVector ===
+// Память под элементы берётся у memory_resource кусками (chunk) по нескольку слотов,
+// освобождённые слоты возвращаются во внутренний интрузивный список и переиспользуются.
+// Адрес слота не меняется до уничтожения пула, поэтому ссылки на элементы стабильны.
+template<typename T>
+class SlabPool {
+private:
+    union Slot {
+        Slot* next;
+        alignas(T) std::byte storage[sizeof(T)];
+    };
+
+    struct ChunkHeader {
+        ChunkHeader* next;
+        size_t slot_count;
+    };
+
+    // Первый кусок маленький, следующие растут вдвое, но не больше ~4 КиБ
+    static constexpr size_t kFirstChunkSlots = 8;
+    static constexpr size_t kMaxChunkBytes = 4096;
+    static constexpr size_t kMaxChunkSlots = std::max<size_t>(kMaxChunkBytes / sizeof(Slot), 64);
+
+    static constexpr size_t kChunkAlignment = std::max(alignof(ChunkHeader), alignof(Slot));
+    static constexpr size_t kHeaderBytes = (sizeof(ChunkHeader) + alignof(Slot) - 1) / alignof(Slot) * alignof(Slot);
+
+    std::pmr::memory_resource* resource;
+    ChunkHeader* chunks = nullptr;
+    Slot* free_list = nullptr;
+    Slot* bump = nullptr;     // ещё не выданные слоты последнего куска
+    Slot* bump_end = nullptr;
+    ChunkHeader* pending = nullptr; // куски после recycle_all, слоты которых ещё не выдавались
+    size_t next_chunk_slots = kFirstChunkSlots;
+    size_t total_slots = 0;
+
+    static size_t chunk_bytes(size_t slot_count) noexcept {
+        return kHeaderBytes + slot_count * sizeof(Slot);
+    }
+
+    static Slot* chunk_slots(ChunkHeader* chunk) noexcept {
+        return reinterpret_cast<Slot*>(reinterpret_cast<std::byte*>(chunk) + kHeaderBytes);
+    }
+
+    // Невыданный остаток текущего куска уходит в список свободных, новый кусок становится текущим
+    void add_chunk(size_t slot_count) {
+        void* raw = resource->allocate(chunk_bytes(slot_count), kChunkAlignment);
+        auto* chunk = static_cast<ChunkHeader*>(raw);
+        chunk->next = chunks;
+        chunk->slot_count = slot_count;
+        chunks = chunk;
+
+        while (bump != bump_end) {
+            Slot* slot = bump++;
+            slot->next = free_list;
+            free_list = slot;
+        }
+        bump = chunk_slots(chunk);
+        bump_end = bump + slot_count;
+        total_slots += slot_count;
+    }
+
+public:
+    explicit SlabPool(std::pmr::memory_resource* res) : resource(res) {}
+
+    ~SlabPool() {
+        release();
+    }
+
+    SlabPool(const SlabPool&) = delete;
+    SlabPool& operator=(const SlabPool&) = delete;
+    SlabPool& operator=(SlabPool&&) = delete;
+
+    // Перемещение забирает все куски вместе со слотами - адреса элементов сохраняются
+    SlabPool(SlabPool&& other) noexcept : resource(other.resource) {
+        swap(other);
+    }
+
+    void swap(SlabPool& other) noexcept {
+        std::swap(resource, other.resource);
+        std::swap(chunks, other.chunks);
+        std::swap(free_list, other.free_list);
+        std::swap(bump, other.bump);
+        std::swap(bump_end, other.bump_end);
+        std::swap(pending, other.pending);
+        std::swap(next_chunk_slots, other.next_chunk_slots);
+        std::swap(total_slots, other.total_slots);
+    }
+
+    T* allocate() {
+        if (free_list) {
+            Slot* slot = free_list;
+            free_list = slot->next;
+            return reinterpret_cast<T*>(slot->storage);
+        }
+        if (bump == bump_end) {
+            if (pending) {
+                bump = chunk_slots(pending);
+                bump_end = bump + pending->slot_count;
+                pending = pending->next;
+            } else {
+                add_chunk(next_chunk_slots);
+                next_chunk_slots = std::min(next_chunk_slots * 2, kMaxChunkSlots);
+            }
+        }
+        return reinterpret_cast<T*>((bump++)->storage);
+    }
+
+    void deallocate(T* p) noexcept {
+        Slot* slot = reinterpret_cast<Slot*>(p);
+        slot->next = free_list;
+        free_list = slot;
+    }
+
+    // Гарантирует, что следующие count вызовов allocate() не обратятся к memory_resource
+    void reserve(size_t count) {
+        size_t available = static_cast<size_t>(bump_end - bump);
+        for (ChunkHeader* chunk = pending; chunk && available < count; chunk = chunk->next) {
+            available += chunk->slot_count;
+        }
+        for (Slot* slot = free_list; slot && available < count; slot = slot->next) {
+            ++available;
+        }
+        if (available < count) {
+            add_chunk(count - available);
+        }
+    }
+
+    // Возвращает все куски в memory_resource. Живых элементов в пуле быть не должно
+    void release() noexcept {
+        while (chunks) {
+            ChunkHeader* next = chunks->next;
+            resource->deallocate(chunks, chunk_bytes(chunks->slot_count), kChunkAlignment);
+            chunks = next;
+        }
+        free_list = nullptr;
+        bump = bump_end = nullptr;
+        pending = nullptr;
+        next_chunk_slots = kFirstChunkSlots;
+        total_slots = 0;
+    }
+
+    // Все слоты снова свободны, куски остаются у пула. Живых элементов быть не должно.
+    // Стоимость не зависит от числа слотов: куски выдаются заново через bump-указатель
+    void recycle_all() noexcept {
+        free_list = nullptr;
+        bump = bump_end = nullptr;
+        pending = chunks;
+    }
+
+    // Возвращает в memory_resource куски, в которых не осталось живых элементов.
+    // Список свободных слотов пересобирается без слотов освобождённых кусков
+    void shrink() {
+        // невыданный остаток текущего куска и ожидающие куски тоже считаются свободными
+        while (bump != bump_end || pending) {
+            if (bump == bump_end) {
+                bump = chunk_slots(pending);
+                bump_end = bump + pending->slot_count;
+                pending = pending->next;
+                continue;
+            }
+            Slot* slot = bump++;
+            slot->next = free_list;
+            free_list = slot;
+        }
+        bump = bump_end = nullptr;
+
+        std::vector<ChunkHeader*> sorted;
+        for (ChunkHeader* chunk = chunks; chunk; chunk = chunk->next) {
+            sorted.push_back(chunk);
+        }
+        std::sort(sorted.begin(), sorted.end(), std::less<ChunkHeader*>());
+
+        // кусок, в который попадает слот: последний с началом не выше адреса слота
+        auto owner = [&](Slot* slot) {
+            auto it = std::upper_bound(sorted.begin(), sorted.end(), slot, [](Slot* s, ChunkHeader* c) {
+                return std::less<const void*>()(s, c);
+            });
+            return static_cast<size_t>(it - sorted.begin()) - 1;
+        };
+
+        std::vector<size_t> free_count(sorted.size(), 0);
+        for (Slot* slot = free_list; slot; slot = slot->next) {
+            ++free_count[owner(slot)];
+        }
+
+        Slot* kept = nullptr;
+        for (Slot* slot = free_list; slot;) {
+            Slot* next = slot->next;
+            size_t id = owner(slot);
+            if (free_count[id] != sorted[id]->slot_count) {
+                slot->next = kept;
+                kept = slot;
+            }
+            slot = next;
+        }
+        free_list = kept;
+
+        ChunkHeader** link = &chunks;
+        while (*link) {
+            ChunkHeader* chunk = *link;
+            size_t id = static_cast<size_t>(std::lower_bound(sorted.begin(), sorted.end(), chunk) - sorted.begin());
+            if (free_count[id] == chunk->slot_count) {
+                *link = chunk->next;
+                total_slots -= chunk->slot_count;
+                resource->deallocate(chunk, chunk_bytes(chunk->slot_count), kChunkAlignment);
+            } else {
+                link = &chunk->next;
+            }
+        }
+        if (!chunks) {
+            next_chunk_slots = kFirstChunkSlots;
+        }
+    }
+
+    size_t slot_capacity() const noexcept {
+        return total_slots;
+    }
+
+    std::pmr::memory_resource* get_resource() const noexcept {
+        return resource;
+    }
+};
+
+} // namespace my_vector
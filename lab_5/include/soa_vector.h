@@ -0,0 +1,269 @@
+#pragma once
+#include <memory_resource>
+#include <vector>
+#include <tuple>
+#include <span>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <cstddef>
+#include <cstdint>
+
+namespace my_vector {
+
+// === Векторизуемые ядра над непрерывными числовыми столбцами ===
+// Циклы помечены "omp simd" (нужен -fopenmp-simd, см. CMakeLists.txt): это разрешает
+// компилятору переупорядочить сложение double и развернуть цикл в SIMD-инструкции.
+// Без флага прагмы игнорируются, и остаются обычные циклы.
+namespace kernels {
+
+// Сумма: целые складываются в int64_t/uint64_t, вещественные - в double
+template<typename T>
+using sum_type = std::conditional_t<std::is_floating_point_v<T>, double,
+                 std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>>;
+
+template<typename T>
+sum_type<T> sum(const T* data, size_t n) noexcept {
+    sum_type<T> total = 0;
+#pragma omp simd reduction(+ : total)
+    for (size_t i = 0; i < n; ++i) {
+        total += static_cast<sum_type<T>>(data[i]);
+    }
+    return total;
+}
+
+template<typename T>
+T min(const T* data, size_t n) noexcept {
+    T result = std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+#pragma omp simd reduction(min : result)
+    for (size_t i = 0; i < n; ++i) {
+        result = data[i] < result ? data[i] : result;
+    }
+    return result;
+}
+
+template<typename T>
+T max(const T* data, size_t n) noexcept {
+    T result = std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::lowest();
+#pragma omp simd reduction(max : result)
+    for (size_t i = 0; i < n; ++i) {
+        result = data[i] > result ? data[i] : result;
+    }
+    return result;
+}
+
+// Индексы элементов, удовлетворяющих pred. Запись без ветвления: индекс пишется
+// всегда, а позиция сдвигается только при совпадении
+template<typename T, typename Predicate>
+size_t filter(const T* data, size_t n, Predicate pred, size_t* out) noexcept {
+    size_t count = 0;
+    for (size_t i = 0; i < n; ++i) {
+        out[count] = i;
+        count += pred(data[i]) ? 1 : 0;
+    }
+    return count;
+}
+
+template<typename T, typename Predicate>
+size_t count_if(const T* data, size_t n, Predicate pred) noexcept {
+    size_t count = 0;
+#pragma omp simd reduction(+ : count)
+    for (size_t i = 0; i < n; ++i) {
+        count += pred(data[i]) ? 1 : 0;
+    }
+    return count;
+}
+
+} // namespace kernels
+
+template<typename MemberPointer>
+struct member_pointer_traits;
+
+template<typename Class, typename Field>
+struct member_pointer_traits<Field Class::*> {
+    using record_type = Class;
+    using field_type = Field;
+};
+
+// === Столбцовый (structure-of-arrays) контейнер записей ===
+// Поля записи перечисляются указателями на члены:
+//     PmrSoAVector<Employee, &Employee::name, &Employee::id, &Employee::salary>
+// Каждое поле хранится в своём std::pmr::vector поверх общего memory_resource,
+// поэтому проход по одному полю читает только его байты, подряд.
+template<typename Record, auto... Fields>
+class PmrSoAVector {
+    static_assert(sizeof...(Fields) > 0, "PmrSoAVector needs at least one field");
+    static_assert((std::is_same_v<typename member_pointer_traits<decltype(Fields)>::record_type, Record> && ...),
+                  "all fields must be members of Record");
+
+public:
+    template<auto Field>
+    using field_type = typename member_pointer_traits<decltype(Field)>::field_type;
+
+private:
+    std::tuple<std::pmr::vector<field_type<Fields>>...> columns;
+
+    // Номер столбца по указателю на член
+    template<auto Field>
+    static constexpr size_t index_of() {
+        size_t index = 0;
+        size_t found = sizeof...(Fields);
+        ((found = (found == sizeof...(Fields) && same_field<Field, Fields>()) ? index : found, ++index), ...);
+        return found;
+    }
+
+    template<auto A, auto B>
+    static constexpr bool same_field() {
+        if constexpr (std::is_same_v<decltype(A), decltype(B)>) {
+            return A == B;
+        } else {
+            return false;
+        }
+    }
+
+    template<auto Field>
+    static constexpr void check_numeric() {
+        static_assert(std::is_arithmetic_v<field_type<Field>>, "vectorized kernels need a numeric column");
+    }
+
+public:
+    explicit PmrSoAVector(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : columns(std::pmr::vector<field_type<Fields>>(resource)...) {}
+
+    // Неявная копия столбцов ушла бы на ресурс по умолчанию - копирование запрещено, как и у PmrVector
+    PmrSoAVector(const PmrSoAVector&) = delete;
+    PmrSoAVector& operator=(const PmrSoAVector&) = delete;
+
+    // Перемещение забирает столбцы вместе с ресурсом; при разных ресурсах элементы перемещаются по одному
+    PmrSoAVector(PmrSoAVector&&) noexcept = default;
+    PmrSoAVector& operator=(PmrSoAVector&&) = default;
+
+    PmrSoAVector(PmrSoAVector&& other, std::pmr::memory_resource* resource)
+        : columns(std::apply(
+              [resource](auto&... column) {
+                  return std::tuple<std::pmr::vector<field_type<Fields>>...>(
+                      std::pmr::vector<field_type<Fields>>(std::move(column), resource)...);
+              },
+              other.columns)) {}
+
+    std::pmr::memory_resource* get_resource() const noexcept {
+        return std::get<0>(columns).get_allocator().resource();
+    }
+
+    // === capacity ===
+    size_t size() const noexcept {
+        return std::get<0>(columns).size();
+    }
+
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    void reserve(size_t new_cap) {
+        std::apply([new_cap](auto&... column) { (column.reserve(new_cap), ...); }, columns);
+    }
+
+    void clear() noexcept {
+        std::apply([](auto&... column) { (column.clear(), ...); }, columns);
+    }
+
+    // === МОДИФИКАТОРЫ ===
+    void push_back(const Record& record) {
+        reserve_for_one();
+        push_fields(record, std::index_sequence_for<decltype(Fields)...>{});
+    }
+
+    void pop_back() {
+        if (empty()) {
+            throw std::runtime_error("pop_back from empty vector");
+        }
+        std::apply([](auto&... column) { (column.pop_back(), ...); }, columns);
+    }
+
+    // === ДОСТУП ===
+    // Собирает запись из столбцов (поля, не перечисленные в Fields, получают значения по умолчанию)
+    Record get(size_t index) const {
+        if (index >= size()) {
+            throw std::out_of_range("index out of range");
+        }
+        Record record{};
+        ((record.*Fields = std::get<index_of<Fields>()>(columns)[index]), ...);
+        return record;
+    }
+
+    template<auto Field>
+    std::span<field_type<Field>> column() noexcept {
+        return std::get<index_of<Field>()>(columns);
+    }
+
+    template<auto Field>
+    std::span<const field_type<Field>> column() const noexcept {
+        return std::get<index_of<Field>()>(columns);
+    }
+
+    // === Агрегаты по числовым столбцам ===
+    template<auto Field>
+    auto sum() const noexcept {
+        check_numeric<Field>();
+        auto col = column<Field>();
+        return kernels::sum(col.data(), col.size());
+    }
+
+    template<auto Field>
+    field_type<Field> min() const {
+        check_numeric<Field>();
+        if (empty()) {
+            throw std::runtime_error("min() of empty vector");
+        }
+        auto col = column<Field>();
+        return kernels::min(col.data(), col.size());
+    }
+
+    template<auto Field>
+    field_type<Field> max() const {
+        check_numeric<Field>();
+        if (empty()) {
+            throw std::runtime_error("max() of empty vector");
+        }
+        auto col = column<Field>();
+        return kernels::max(col.data(), col.size());
+    }
+
+    // Индексы строк, у которых значение поля удовлетворяет pred
+    template<auto Field, typename Predicate>
+    std::pmr::vector<size_t> filter(Predicate pred, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const {
+        auto col = column<Field>();
+        std::pmr::vector<size_t> indices(col.size() + 1, resource);
+        indices.resize(kernels::filter(col.data(), col.size(), pred, indices.data()));
+        return indices;
+    }
+
+    template<auto Field, typename Predicate>
+    size_t count_if(Predicate pred) const {
+        auto col = column<Field>();
+        return kernels::count_if(col.data(), col.size(), pred);
+    }
+
+private:
+    // Рост всех столбцов сразу, чтобы исключение не оставило столбцы разной длины
+    void reserve_for_one() {
+        size_t cap = std::get<0>(columns).capacity();
+        if (size() == cap) {
+            reserve(cap == 0 ? 8 : cap * 2);
+        }
+    }
+
+    // Если копирование поля бросило исключение, уже добавленные поля убираются
+    template<size_t... I>
+    void push_fields(const Record& record, std::index_sequence<I...>) {
+        size_t pushed = 0;
+        try {
+            ((std::get<I>(columns).push_back(record.*Fields), ++pushed), ...);
+        } catch (...) {
+            ((I < pushed ? std::get<I>(columns).pop_back() : void()), ...);
+            throw;
+        }
+    }
+};
+
+} // namespace my_vector
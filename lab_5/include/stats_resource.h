@@ -0,0 +1,122 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace my_vector {
+
+// === Гистограмма задержек ===
+// Лог-линейные корзины: точные значения до 16, дальше 16 корзин на каждую степень двойки
+// (относительная ошибка квантиля не больше 1/16). Значения - в тиках LowOverheadClock.
+class LatencyHistogram {
+public:
+    static constexpr size_t kSubBuckets = 16;
+    static constexpr size_t kBuckets = 64 * kSubBuckets;
+
+    void record(uint64_t value) noexcept;
+
+    // Верхняя граница корзины, в которую попал квантиль q (0..1); 0 - если записей нет
+    uint64_t percentile(double q) const noexcept;
+
+    uint64_t count() const noexcept {
+        return total;
+    }
+
+    uint64_t max() const noexcept {
+        return max_value;
+    }
+
+    void reset() noexcept;
+
+private:
+    std::array<uint64_t, kBuckets> buckets{};
+    uint64_t total = 0;
+    uint64_t max_value = 0;
+};
+
+// === Дешёвые часы для замеров в горячем пути ===
+// На x86-64 - счётчик тактов (rdtsc, без сериализации), иначе steady_clock.
+// Перевод в наносекунды калибруется один раз при первом обращении к ticks_per_ns()
+struct LowOverheadClock {
+    static uint64_t now() noexcept;
+    static double ticks_per_ns();
+};
+
+// Снимок статистики StatsResource
+struct AllocStats {
+    static constexpr size_t kSizeClasses = 64;  // класс k: размер в (2^(k-1), 2^k]
+    static constexpr size_t kLifetimeBuckets = 64; // корзина k: время жизни в [2^k, 2^(k+1)) нс
+
+    uint64_t allocations = 0;
+    uint64_t deallocations = 0;
+    uint64_t reuse_hits = 0;      // выданный адрес ранее уже освобождался через этот ресурс
+    uint64_t bytes_live = 0;
+    uint64_t bytes_freed = 0;     // суммарно возвращено
+    uint64_t bytes_peak = 0;
+    uint64_t bytes_allocated = 0; // суммарно выдано
+
+    std::array<uint64_t, kSizeClasses> size_classes{};
+    std::array<uint64_t, kLifetimeBuckets> lifetime_ns{};
+
+    // Квантили задержек в наносекундах
+    double allocate_p50_ns = 0, allocate_p99_ns = 0, allocate_p999_ns = 0;
+    double deallocate_p50_ns = 0, deallocate_p99_ns = 0, deallocate_p999_ns = 0;
+
+    double reuse_rate() const noexcept {
+        return allocations ? static_cast<double>(reuse_hits) / static_cast<double>(allocations) : 0.0;
+    }
+
+    void dump_json(std::ostream& os) const;
+};
+
+// === Декоратор со статистикой над любым memory_resource ===
+// Считает операции, байты, повторное использование адресов, распределение размеров,
+// времена жизни блоков и задержки allocate/deallocate вышестоящего ресурса.
+// Учёт защищён мьютексом, сам вызов upstream выполняется вне его; при освобождении
+// учёт обновляется до возврата блока upstream.
+class StatsResource : public std::pmr::memory_resource {
+public:
+    explicit StatsResource(std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+
+    StatsResource(const StatsResource&) = delete;
+    StatsResource& operator=(const StatsResource&) = delete;
+
+    std::pmr::memory_resource* upstream_resource() const noexcept {
+        return upstream;
+    }
+
+    AllocStats stats() const;
+
+    // Обнуляет счётчики; живые блоки остаются на учёте
+    void reset();
+
+    void dump_json(std::ostream& os) const;
+    void dump_json(const std::string& path) const;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    void remember_released(void* p) noexcept;
+
+    static constexpr size_t kMaxReleased = size_t{1} << 16;
+
+    std::pmr::memory_resource* upstream;
+    double ticks_per_ns;
+
+    mutable std::mutex mutex;
+    AllocStats counters;
+    LatencyHistogram allocate_latency;
+    LatencyHistogram deallocate_latency;
+    std::unordered_map<void*, uint64_t> live;   // адрес -> момент выдачи (тики)
+    std::unordered_set<void*> released;        // адреса, освобождённые и ещё не выданные повторно (не больше kMaxReleased)
+};
+
+} // namespace my_vector
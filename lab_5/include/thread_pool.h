@@ -0,0 +1,66 @@
+#pragma once
+#include <memory_resource>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace my_vector::parallel {
+
+// === Пул потоков с перехватом задач (work stealing) ===
+// У каждого рабочего потока своя очередь: владелец берёт задачи с конца (LIFO - свежие,
+// горячие в кэше), остальные потоки забирают с начала (FIFO - самые крупные куски
+// рекурсивного разбиения). Задачи, порождённые вне пула, раскладываются по очередям по кругу.
+// Поток, ожидающий завершения работы (help_while), сам выполняет задачи из очередей,
+// поэтому вложенные параллельные вызовы не блокируют пул.
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit ThreadPool(size_t threads = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Число рабочих потоков (вызывающий поток в ожидании работает как ещё один)
+    size_t size() const noexcept {
+        return queues.size();
+    }
+
+    void spawn(Task task);
+
+    // Выполняет задачи из очередей, пока pending() возвращает true
+    void help_while(const std::function<bool()>& pending);
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex sleep_mutex;
+    std::condition_variable wake;
+    std::atomic<size_t> queued{0};
+    std::atomic<size_t> next_queue{0};
+    bool stopping = false;
+
+    bool try_pop_local(size_t index, Task& task);
+    bool try_steal(size_t thief, Task& task);
+    bool try_take(Task& task);
+    void worker_loop(size_t index);
+};
+
+// Ресурс для временных данных внутри задачи: свой у каждого потока, без синхронизации.
+// Память, взятая у него, должна освобождаться в том же потоке
+std::pmr::memory_resource* scratch_resource();
+
+} // namespace my_vector::parallel
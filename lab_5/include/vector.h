@@ -1,14 +1,27 @@
 #pragma once
 #include "my_memory_resource.h"
 #include "vector_iterator.h"
+#include "slab_pool.h"
+#include "inline_storage.h"
+#include "relocation.h"
 #include <memory_resource>
 #include <stdexcept>
+#include <utility>
+#include <algorithm>
+#include <iterator>
+#include <ranges>
+#include <functional>
+#include <cstring>
+#include <type_traits>
+#include <vector>
 
 namespace my_vector {
 
 // === 4. Реализация шаблонного контейнера согласно варианту задания - динамический массив, === 
 // === который использует созданный memory_resource через шаблон std::pmr::polymorphic_allocator === 
-template<typename T>
+// InlineCapacity > 0 - первые InlineCapacity элементов и таблица указателей хранятся
+// прямо в объекте, и короткий вектор совсем не обращается к memory_resource
+template<typename T, size_t InlineCapacity = 0>
 class PmrVector {
 private:
     using value_allocator_type  = std::pmr::polymorphic_allocator<T>;
@@ -17,50 +30,314 @@ private:
     using pointer_allocator_type = std::pmr::polymorphic_allocator<T*>;
     using pointer_traits = std::allocator_traits<pointer_allocator_type>;
 
-    T** pointers = nullptr;
+    template<typename, size_t>
+    friend class PmrVector;
+
+    [[no_unique_address]] InlineStorage<T, InlineCapacity> inline_buf;
+
+    T** pointers = inline_buf.table_data();
     size_t vec_size = 0;
-    size_t vec_capacity = 0;
+    size_t vec_capacity = InlineCapacity;
+
+    // Надгробия - позиции, где элемент удалён через mark_erased, а указатель равен nullptr
+    size_t tombstones = 0;
+    double compaction_ratio = 0.0; // 0 - compact() только явно
 
     value_allocator_type val_alloc;
     pointer_allocator_type ptr_alloc;
+
+    // слоты под элементы выделяются кусками, а не по одному на элемент
+    SlabPool<T> slots;
     
     // === РАСШИРЕНИЕ ЁМКОСТИ === 
     void reallocate_pointers(size_t new_cap) {
-        // выделяем новый блок для массива указателей (тип T*)
-        T** new_table = ptr_alloc.allocate(new_cap);
+        // до InlineCapacity хватает встроенной таблицы, иначе выделяем новый блок (тип T*)
+        T** new_table = (new_cap <= InlineCapacity) ? inline_buf.table_data() : ptr_alloc.allocate(new_cap);
+        if (new_table == pointers) {
+            return;
+        }
 
-        // копируем старые указатели
-        for (size_t i = 0; i < vec_size; ++i) {
-            new_table[i] = pointers ? pointers[i] : nullptr;
+        // копируем старые указатели одним блоком
+        copy_pointers(pointers, vec_size, new_table);
+
+        free_table();
+        pointers = new_table;
+        vec_capacity = std::max(new_cap, InlineCapacity);
+    }
+
+    // Таблица указателей всегда тривиально перемещаема: сдвиги и копирование - memmove/memcpy
+    static void copy_pointers(T* const* src, size_t count, T** dst) noexcept {
+        if (count) {
+            std::memcpy(dst, src, count * sizeof(T*));
+        }
+    }
+
+    static void move_pointers(T** src, size_t count, T** dst) noexcept {
+        if (count) {
+            std::memmove(dst, src, count * sizeof(T*));
         }
+    }
 
-        if (pointers) {
+    void free_table() noexcept {
+        if (pointers && !inline_buf.owns_table(pointers)) {
             ptr_alloc.deallocate(pointers, vec_capacity);
         }
+    }
 
-        pointers = new_table;
-        vec_capacity = new_cap;
+    // Одно вычисление ёмкости под extra новых элементов: таблица растёт не более одного раза
+    void reserve_for(size_t extra) {
+        size_t needed = vec_size + extra;
+        if (needed > vec_capacity) {
+            reallocate_pointers(std::max(needed, vec_capacity * 2));
+        }
+        reserve_slots(extra);
     }
 
-public:
-    using Iterator = VectorIterator<T>;
+    // Слоты в пуле нужны только сверх свободных встроенных
+    void reserve_slots(size_t count) {
+        size_t inline_free = inline_buf.free_count();
+        if (count > inline_free) {
+            slots.reserve(count - inline_free);
+        }
+    }
 
-    PmrVector(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) : val_alloc(resource), ptr_alloc(resource) {}
+    // Откат частично выполненной групповой операции: удаляем элементы с индекса from до конца
+    void truncate(size_t from) noexcept {
+        while (vec_size > from) {
+            --vec_size;
+            release_position(vec_size);
+        }
+    }
 
-    ~PmrVector() {
+    // Уничтожает элемент на позиции index (или снимает надгробие) и обнуляет указатель
+    void release_position(size_t index) noexcept {
+        if (pointers[index]) {
+            destroy_element(pointers[index]);
+            pointers[index] = nullptr;
+        } else {
+            --tombstones;
+        }
+    }
+
+    // Закрывает дыру [kept, from) после прерванного уплотнения: хвост [from, vec_size)
+    // сдвигается к kept, освободившийся конец таблицы обнуляется
+    void close_gap(size_t kept, size_t from) noexcept {
+        size_t tail = vec_size - from;
+        move_pointers(pointers + from, tail, pointers + kept);
+        std::fill(pointers + kept + tail, pointers + vec_size, nullptr);
+        vec_size = kept + tail;
+    }
+
+    void grow_if_full() {
+        if (vec_size == vec_capacity) {
+            size_t new_cap = (vec_capacity == 0) ? 2 : (vec_capacity * 2);
+            reallocate_pointers(new_cap);
+        }
+    }
+
+    // Слот (встроенный, если есть свободный, иначе из пула) + конструирование объекта в нём;
+    // при исключении слот возвращается обратно
+    template<typename... Args>
+    T* create_element(Args&&... args) {
+        T* p = inline_buf.allocate();
+        if (!p) {
+            p = slots.allocate();
+        }
+        try {
+            value_traits::construct(val_alloc, p, std::forward<Args>(args)...);
+        } catch (...) {
+            release_slot(p);
+            throw;
+        }
+        return p;
+    }
+
+    void release_slot(T* p) noexcept {
+        if (!inline_buf.deallocate(p)) {
+            slots.deallocate(p);
+        }
+    }
+
+    void destroy_element(T* p) noexcept {
+        value_traits::destroy(val_alloc, p);
+        release_slot(p);
+    }
+
+    template<typename... Args>
+    void resize_impl(size_t new_size, const Args&... value) {
+        if (new_size <= vec_size) {
+            truncate(new_size);
+            return;
+        }
+        size_t old_size = vec_size;
+        reserve_for(new_size - vec_size);
+        try {
+            while (vec_size < new_size) {
+                emplace_back(value...);
+            }
+        } catch (...) {
+            truncate(old_size);
+            throw;
+        }
+    }
+
+    // Освобождает элементы и таблицу указателей, вектор становится пустым
+    void release_storage() noexcept {
         clear();
-        if (pointers) {
-            ptr_alloc.deallocate(pointers, vec_capacity);
-            pointers = nullptr;
-            vec_capacity = 0;
+        free_table();
+        pointers = inline_buf.table_data();
+        vec_capacity = InlineCapacity;
+    }
+
+    // Забирает таблицу и слоты у other (ресурсы должны совпадать, сам вектор пуст).
+    // Встроенный буфер забрать нельзя: его указатели копируются в свою встроенную
+    // таблицу, а элементы из встроенных слотов other переносятся в те же слоты у себя
+    void steal(PmrVector& other) noexcept(InlineCapacity == 0 || std::is_nothrow_move_constructible_v<T>) {
+        if (other.inline_buf.owns_table(other.pointers)) {
+            copy_pointers(other.pointers, other.vec_size, inline_buf.table_data());
+            pointers = inline_buf.table_data();
+            vec_capacity = InlineCapacity;
+        } else {
+            pointers = other.pointers;
+            vec_capacity = other.vec_capacity;
         }
+        vec_size = other.vec_size;
+        tombstones = std::exchange(other.tombstones, 0);
+        slots.swap(other.slots);
+
+        if constexpr (InlineCapacity > 0) {
+            for (size_t i = 0; i < vec_size; ++i) {
+                T* p = pointers[i];
+                if (p && other.inline_buf.owns(p)) {
+                    size_t index = other.inline_buf.index_of(p);
+                    T* target = inline_buf.slot(index);
+                    if constexpr (is_trivially_relocatable_v<T>) {
+                        std::memcpy(static_cast<void*>(target), static_cast<const void*>(p), sizeof(T));
+                    } else {
+                        value_traits::construct(val_alloc, target, std::move(*p));
+                        value_traits::destroy(other.val_alloc, p);
+                    }
+                    inline_buf.mark_used(index);
+                    pointers[i] = target;
+                }
+            }
+            other.inline_buf.reset();
+        }
+
+        other.pointers = other.inline_buf.table_data();
+        other.vec_size = 0;
+        other.vec_capacity = InlineCapacity;
     }
 
-    // === Запрешаем копирование и перемещение ===
+    // Сравнение элементов по указателям из таблицы
+    template<typename Compare, typename Proj>
+    static auto pointer_comparator(Compare& comp, Proj& proj) {
+        return [&comp, &proj](const T* a, const T* b) {
+            return std::invoke(comp, std::invoke(proj, *a), std::invoke(proj, *b));
+        };
+    }
+
+    // Поэлементное перемещение, когда ресурсы разные и украсть память нельзя.
+    // Если перемещение элемента бросило, уже перенесённые уничтожаются вместе с таблицей:
+    // при вызове из конструктора деструктор вектора не запустится
+    void move_elements_from(PmrVector& other) {
+        try {
+            reserve(other.vec_size - other.tombstones);
+            for (size_t i = 0; i < other.vec_size; ++i) {
+                if (other.pointers[i]) {
+                    pointers[vec_size] = create_element(std::move(*other.pointers[i]));
+                    ++vec_size;
+                }
+            }
+        } catch (...) {
+            release_storage();
+            throw;
+        }
+        other.clear();
+    }
+
+    // Позиция первого/последнего живого элемента (надгробия пропускаются); vec_size - если живых нет
+    size_t first_live() const noexcept {
+        size_t index = 0;
+        while (index < vec_size && !pointers[index]) {
+            ++index;
+        }
+        return index;
+    }
+
+    size_t last_live() const noexcept {
+        for (size_t index = vec_size; index > 0; --index) {
+            if (pointers[index - 1]) {
+                return index - 1;
+            }
+        }
+        return vec_size;
+    }
+
+public:
+    using Iterator = VectorIterator<T>;
+    using ConstIterator = VectorIterator<T, true>;
+    using ReverseIterator = std::reverse_iterator<Iterator>;
+    using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+
+    // Имена в стиле стандартной библиотеки - для std::ranges и обобщённого кода
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = Iterator;
+    using const_iterator = ConstIterator;
+    using reverse_iterator = ReverseIterator;
+    using const_reverse_iterator = ConstReverseIterator;
+
+    using LiveIter = LiveIterator<T>;
+    using ConstLiveIter = LiveIterator<T, true>;
+
+    PmrVector(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) : val_alloc(resource), ptr_alloc(resource), slots(resource) {}
+
+    ~PmrVector() {
+        release_storage();
+    }
+
+    // === Копирование запрещено ===
     PmrVector(const PmrVector&) = delete;
     PmrVector& operator=(const PmrVector&) = delete;
-    PmrVector(PmrVector&&) = delete;
-    PmrVector& operator=(PmrVector&&) = delete;
+
+    // === Перемещение: таблица указателей и слоты забираются целиком, элементы не копируются ===
+    PmrVector(PmrVector&& other) noexcept(InlineCapacity == 0 || std::is_nothrow_move_constructible_v<T>)
+        : val_alloc(other.val_alloc), ptr_alloc(other.ptr_alloc), slots(other.slots.get_resource()) {
+        steal(other);
+    }
+
+    // Перемещение в вектор с указанным ресурсом: при равных ресурсах память забирается,
+    // иначе элементы перемещаются по одному в память нового ресурса
+    PmrVector(PmrVector&& other, std::pmr::memory_resource* resource)
+        : val_alloc(resource), ptr_alloc(resource), slots(resource) {
+        if (val_alloc == other.val_alloc) {
+            steal(other);
+        } else {
+            move_elements_from(other);
+        }
+    }
+
+    // polymorphic_allocator не распространяется при присваивании - ресурс остаётся прежним
+    PmrVector& operator=(PmrVector&& other) {
+        if (this == &other) {
+            return *this;
+        }
+        release_storage();
+        if (val_alloc == other.val_alloc) {
+            steal(other);
+        } else {
+            move_elements_from(other);
+        }
+        return *this;
+    }
+
+    std::pmr::memory_resource* get_resource() const noexcept {
+        return val_alloc.resource();
+    }
 
     // === capacity ===
     size_t size() const noexcept {
@@ -79,6 +356,22 @@ public:
         if (new_cap > vec_capacity) {
             reallocate_pointers(new_cap);
         }
+        if (new_cap > vec_size) {
+            reserve_slots(new_cap - vec_size);
+        }
+    }
+
+    // Подгоняет таблицу указателей под размер и возвращает memory_resource
+    // куски слотов, в которых не осталось элементов
+    void shrink_to_fit() {
+        if (vec_size == 0) {
+            free_table();
+            pointers = inline_buf.table_data();
+            vec_capacity = InlineCapacity;
+        } else if (vec_size < vec_capacity) {
+            reallocate_pointers(vec_size);
+        }
+        slots.shrink();
     }
 
     // === ДОСТУП К ЭЛЕМЕНТУ ===
@@ -94,6 +387,9 @@ public:
         if (index >= vec_size) {
             throw std::out_of_range("index out of range");
         }
+        if (!pointers[index]) {
+            throw std::out_of_range("element is erased");
+        }
         return *pointers[index];
     }
 
@@ -101,131 +397,486 @@ public:
         if (index >= vec_size) {
             throw std::out_of_range("index out of range");
         }
+        if (!pointers[index]) {
+            throw std::out_of_range("element is erased");
+        }
         return *pointers[index];
     }
 
     // === МОДИФИКАТОРЫ ===
     void push_back(const T& value) {
-        if (vec_size == vec_capacity) {
-            size_t new_cap = (vec_capacity == 0) ? 2 : (vec_capacity * 2);
-            reallocate_pointers(new_cap);
-        }
+        emplace_back(value);
+    }
 
-        // выделяем место для объекта через value allocator
-        T* p = val_alloc.allocate(1);
-        try {
-            value_traits::construct(val_alloc, p, value);
-        } catch (...) {
-            val_alloc.deallocate(p, 1);
-            throw;
-        }
+    void push_back(T&& value) {
+        emplace_back(std::move(value));
+    }
 
+    // Конструирует элемент сразу в слоте пула, без временного объекта
+    template<typename... Args>
+    T& emplace_back(Args&&... args) {
+        grow_if_full();
+        T* p = create_element(std::forward<Args>(args)...);
         pointers[vec_size] = p;
         ++vec_size;
+        return *p;
     }
 
     void pop_back() {
         if (empty()) { 
             throw std::runtime_error("pop_back from empty vector");
         }
-        T* p = pointers[vec_size - 1];
-        value_traits::destroy(val_alloc, p);
-        val_alloc.deallocate(p, 1);
-        pointers[vec_size - 1] = nullptr;
         --vec_size;
+        release_position(vec_size);
     }
 
     void clear() {
-        for (size_t i = 0; i < vec_size; ++i) {
-            if (pointers[i]) {
-                value_traits::destroy(val_alloc, pointers[i]);
-                val_alloc.deallocate(pointers[i], 1);
-                pointers[i] = nullptr;
+        if constexpr (std::is_trivially_destructible_v<T>) {
+            // деструкторы вызывать не нужно - все слоты возвращаются пулу разом
+            inline_buf.reset();
+            slots.recycle_all();
+        } else {
+            for (size_t i = 0; i < vec_size; ++i) {
+                if (pointers[i]) {
+                    destroy_element(pointers[i]);
+                    pointers[i] = nullptr;
+                }
             }
         }
         vec_size = 0;
+        tombstones = 0;
     }
 
     // === front/back ===
+    // Первый/последний живой элемент: надгробия (mark_erased) пропускаются
     T& front() {
-        if (empty()) {
+        size_t index = first_live();
+        if (index == vec_size) {
             throw std::runtime_error("front() from empty vector");
         }
-        return *pointers[0];
+        return *pointers[index];
     }
 
     const T& front() const {
-        if (empty()) { 
-            throw std::runtime_error("front() from empty vector");
-        }
-        return *pointers[0];
+        return const_cast<PmrVector*>(this)->front();
     }
 
     T& back() {
-        if (empty()) {
+        size_t index = last_live();
+        if (index == vec_size) {
             throw std::runtime_error("back() from empty vector");
         }
-        return *pointers[vec_size - 1];
+        return *pointers[index];
     }
+
     const T& back() const {
-        if (empty()) {
-            throw std::runtime_error("back() from empty vector");
-        }
-        return *pointers[vec_size - 1];
+        return const_cast<PmrVector*>(this)->back();
     }
 
     // === ВСТАВКА/УДАЛЕНИЕ ПО ИНДЕКСУ ===
     void insert(size_t index, const T& value) {
+        emplace(index, value);
+    }
+
+    void insert(size_t index, T&& value) {
+        emplace(index, std::move(value));
+    }
+
+    template<typename... Args>
+    T& emplace(size_t index, Args&&... args) {
         if (index > vec_size) {
             throw std::out_of_range("insert index out of range");
         }
-        if (vec_size == vec_capacity) {
-            size_t new_cap = (vec_capacity == 0) ? 2 : (vec_capacity * 2);
-            reallocate_pointers(new_cap);
-        }
+        grow_if_full();
+
+        // сначала создаём элемент - если конструктор бросит, таблица не изменится
+        T* p = create_element(std::forward<Args>(args)...);
 
         // сдвигаем указатели вправо
-        for (size_t i = vec_size; i > index; --i) {
-            pointers[i] = pointers[i - 1];
+        move_pointers(pointers + index, vec_size - index, pointers + index + 1);
+
+        pointers[index] = p;
+        ++vec_size;
+        return *p;
+    }
+
+    void erase(size_t index) {
+        if (index >= vec_size) { 
+            throw std::out_of_range("erase index out of range");
         }
 
-        // выделяем блок под новый элемент
-        T* p = val_alloc.allocate(1);
+        release_position(index);
+
+        move_pointers(pointers + index + 1, vec_size - index - 1, pointers + index);
+        pointers[vec_size - 1] = nullptr;
+        --vec_size;
+    }
+
+    // === ГРУППОВЫЕ ОПЕРАЦИИ ===
+    // Каждая выполняет не более одного перевыделения таблицы и один проход сдвига
+
+    // Вставка диапазона перед позицией index: элементы добавляются в конец,
+    // затем за один std::rotate встают на место
+    template<std::input_iterator InputIt, std::sentinel_for<InputIt> Sentinel>
+    void insert(size_t index, InputIt first, Sentinel last) {
+        if (index > vec_size) {
+            throw std::out_of_range("insert index out of range");
+        }
+        size_t old_size = vec_size;
+        if constexpr (std::forward_iterator<InputIt>) {
+            reserve_for(static_cast<size_t>(std::ranges::distance(first, last)));
+        }
         try {
-            value_traits::construct(val_alloc, p, value);
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
         } catch (...) {
-            val_alloc.deallocate(p, 1);
-            for (size_t i = index; i < vec_size; ++i) { 
-                pointers[i] = pointers[i + 1];
+            truncate(old_size);
+            throw;
+        }
+        std::rotate(pointers + index, pointers + old_size, pointers + vec_size);
+    }
+
+    template<std::ranges::input_range Range>
+    void append_range(Range&& range) {
+        if constexpr (std::ranges::sized_range<Range>) {
+            reserve_for(static_cast<size_t>(std::ranges::size(range)));
+        }
+        insert(vec_size, std::ranges::begin(range), std::ranges::end(range));
+    }
+
+    // Удаление полуинтервала [first, last)
+    void erase(size_t first, size_t last) {
+        if (first > last || last > vec_size) {
+            throw std::out_of_range("erase range out of range");
+        }
+        for (size_t i = first; i < last; ++i) {
+            release_position(i);
+        }
+        move_pointers(pointers + last, vec_size - last, pointers + first);
+        std::fill(pointers + vec_size - (last - first), pointers + vec_size, nullptr);
+        vec_size -= last - first;
+    }
+
+    // Удаляет все элементы, удовлетворяющие pred, за один проход; возвращает число удалённых.
+    // Надгробия убираются попутно (в счёт не входят)
+    template<typename Predicate>
+    size_t erase_if(Predicate pred) {
+        size_t kept = 0;
+        size_t removed = 0;
+        size_t skipped_tombstones = 0;
+        size_t i = 0;
+        try {
+            for (; i < vec_size; ++i) {
+                T* p = pointers[i];
+                if (!p) {
+                    ++skipped_tombstones;
+                    continue;
+                }
+                if (pred(*p)) {
+                    destroy_element(p);
+                    ++removed;
+                } else {
+                    pointers[kept++] = p;
+                }
             }
+        } catch (...) {
+            // необработанный хвост [i, vec_size) придвигаем к оставленным элементам
+            close_gap(kept, i);
+            tombstones -= skipped_tombstones;
             throw;
         }
+        close_gap(kept, vec_size);
+        tombstones = 0;
+        return removed;
+    }
 
-        pointers[index] = p;
-        ++vec_size;
+    // === ОТЛОЖЕННОЕ УДАЛЕНИЕ ===
+    // mark_erased уничтожает элемент, но оставляет на его месте надгробие (nullptr):
+    // индексы остальных элементов не меняются, сдвига нет. size() учитывает надгробия,
+    // обращаться к ним через []/итераторы нельзя - для обхода живых элементов есть live().
+    // compact() убирает все надгробия одним проходом с сохранением порядка
+    void mark_erased(size_t index) {
+        if (index >= vec_size) {
+            throw std::out_of_range("mark_erased index out of range");
+        }
+        if (!pointers[index]) {
+            return;
+        }
+        destroy_element(pointers[index]);
+        pointers[index] = nullptr;
+        ++tombstones;
+        if (compaction_ratio > 0.0 && static_cast<double>(tombstones) > compaction_ratio * static_cast<double>(vec_size)) {
+            compact();
+        }
     }
 
-    void erase(size_t index) {
-        if (index >= vec_size) { 
-            throw std::out_of_range("erase index out of range");
+    bool is_erased(size_t index) const {
+        if (index >= vec_size) {
+            throw std::out_of_range("index out of range");
         }
+        return pointers[index] == nullptr;
+    }
 
-        T* p = pointers[index];
-        value_traits::destroy(val_alloc, p);
-        val_alloc.deallocate(p, 1);
+    size_t tombstone_count() const noexcept {
+        return tombstones;
+    }
+
+    size_t live_size() const noexcept {
+        return vec_size - tombstones;
+    }
 
-        for (size_t i = index; i + 1 < vec_size; ++i) {
-            pointers[i] = pointers[i + 1];
+    // Доля надгробий, при превышении которой mark_erased сам вызывает compact() (индексы сдвигаются);
+    // 0 - автоматическое уплотнение выключено
+    void set_compaction_ratio(double ratio) {
+        if (ratio < 0.0 || ratio > 1.0) {
+            throw std::out_of_range("compaction ratio must be in [0, 1]");
         }
+        compaction_ratio = ratio;
+    }
+
+    double get_compaction_ratio() const noexcept {
+        return compaction_ratio;
+    }
+
+    // Убирает надгробия, сохраняя порядок живых элементов; возвращает число убранных
+    size_t compact() noexcept {
+        if (tombstones == 0) {
+            return 0;
+        }
+        T** kept_end = std::remove(pointers, pointers + vec_size, nullptr);
+        size_t removed = static_cast<size_t>(pointers + vec_size - kept_end);
+        vec_size -= removed;
+        tombstones = 0;
+        return removed;
+    }
+
+    // Удаление за O(1) без сохранения порядка: на место index переезжает последний указатель
+    void swap_erase(size_t index) {
+        if (index >= vec_size) {
+            throw std::out_of_range("swap_erase index out of range");
+        }
+        release_position(index);
+        pointers[index] = pointers[vec_size - 1];
         pointers[vec_size - 1] = nullptr;
         --vec_size;
     }
 
+    // === ПЕРЕСТАНОВКИ ТАБЛИЦЫ УКАЗАТЕЛЕЙ ===
+    // Переупорядочивание меняет местами только указатели (8 байт), сами элементы не перемещаются:
+    // ссылки на элементы остаются действительными, меняются только их индексы.
+    // comp/pred применяются к proj(element); надгробия предварительно убираются compact()
+
+    template<typename Compare = std::ranges::less, typename Proj = std::identity>
+    void sort(Compare comp = {}, Proj proj = {}) {
+        compact();
+        std::sort(pointers, pointers + vec_size, pointer_comparator(comp, proj));
+    }
+
+    template<typename Compare = std::ranges::less, typename Proj = std::identity>
+    void stable_sort(Compare comp = {}, Proj proj = {}) {
+        compact();
+        std::stable_sort(pointers, pointers + vec_size, pointer_comparator(comp, proj));
+    }
+
+    // Элементы, для которых pred истинен, оказываются в начале; возвращает индекс первого из остальных
+    template<typename Predicate, typename Proj = std::identity>
+    size_t partition(Predicate pred, Proj proj = {}) {
+        compact();
+        T** middle = std::partition(pointers, pointers + vec_size, [&](T* p) {
+            return std::invoke(pred, std::invoke(proj, *p));
+        });
+        return static_cast<size_t>(middle - pointers);
+    }
+
+    // На позиции n оказывается элемент, который стоял бы там после sort; слева - не больше, справа - не меньше
+    template<typename Compare = std::ranges::less, typename Proj = std::identity>
+    void nth_element(size_t n, Compare comp = {}, Proj proj = {}) {
+        compact();
+        if (n >= vec_size) {
+            throw std::out_of_range("nth_element index out of range");
+        }
+        std::nth_element(pointers, pointers + n, pointers + vec_size, pointer_comparator(comp, proj));
+    }
+
+    // Удаляет подряд идущие равные элементы (остаётся первый из группы); возвращает число удалённых
+    template<typename Equal = std::ranges::equal_to, typename Proj = std::identity>
+    size_t unique(Equal eq = {}, Proj proj = {}) {
+        compact();
+        if (vec_size == 0) {
+            return 0;
+        }
+        size_t kept = 1;
+        size_t i = 1;
+        try {
+            for (; i < vec_size; ++i) {
+                T* p = pointers[i];
+                if (std::invoke(eq, std::invoke(proj, *pointers[kept - 1]), std::invoke(proj, *p))) {
+                    destroy_element(p);
+                } else {
+                    pointers[kept++] = p;
+                }
+            }
+        } catch (...) {
+            close_gap(kept, i);
+            throw;
+        }
+        size_t removed = vec_size - kept;
+        close_gap(kept, vec_size);
+        return removed;
+    }
+
+    // === ДЕФРАГМЕНТАЦИЯ ===
+    // Переносит элементы из пула в один новый кусок памяти подряд в порядке индексов
+    // (для тривиально перемещаемых T - memcpy), переписывает таблицу указателей и
+    // возвращает ресурсу старые куски. Элементы во встроенном буфере остаются на месте.
+    // Адреса перенесённых элементов меняются. Возвращает число перенесённых байт
+    size_t defragment() {
+        compact();
+        size_t pooled = 0;
+        for (size_t i = 0; i < vec_size; ++i) {
+            pooled += inline_buf.owns(pointers[i]) ? 0 : 1;
+        }
+        if (pooled == 0) {
+            slots.shrink();
+            return 0;
+        }
+
+        SlabPool<T> fresh(slots.get_resource());
+        fresh.reserve(pooled); // один кусок ровно под все элементы
+
+        if constexpr (is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>) {
+            for (size_t i = 0; i < vec_size; ++i) {
+                T* old = pointers[i];
+                if (inline_buf.owns(old)) {
+                    continue;
+                }
+                T* moved = fresh.allocate();
+                if constexpr (is_trivially_relocatable_v<T>) {
+                    std::memcpy(static_cast<void*>(moved), static_cast<const void*>(old), sizeof(T));
+                } else {
+                    value_traits::construct(val_alloc, moved, std::move(*old));
+                    value_traits::destroy(val_alloc, old);
+                }
+                pointers[i] = moved;
+            }
+        } else {
+            // перемещение может бросить - сначала копии всех элементов, потом уничтожение старых
+            std::vector<T*> copies;
+            copies.reserve(pooled);
+            try {
+                for (size_t i = 0; i < vec_size; ++i) {
+                    if (!inline_buf.owns(pointers[i])) {
+                        T* copy = fresh.allocate();
+                        value_traits::construct(val_alloc, copy, *pointers[i]);
+                        copies.push_back(copy);
+                    }
+                }
+            } catch (...) {
+                for (T* copy : copies) {
+                    value_traits::destroy(val_alloc, copy);
+                }
+                throw;
+            }
+            size_t next = 0;
+            for (size_t i = 0; i < vec_size; ++i) {
+                if (!inline_buf.owns(pointers[i])) {
+                    value_traits::destroy(val_alloc, pointers[i]);
+                    pointers[i] = copies[next++];
+                }
+            }
+        }
+
+        // в старом пуле живых элементов не осталось - его куски освобождает деструктор fresh
+        slots.swap(fresh);
+        return pooled * sizeof(T);
+    }
+
+    // === ПОИСК В ОТСОРТИРОВАННОМ ВЕКТОРЕ ===
+    // Вектор должен быть упорядочен по proj тем же comp и не содержать надгробий; результат - индексы
+
+    template<typename Key, typename Compare = std::ranges::less, typename Proj = std::identity>
+    size_t lower_bound(const Key& key, Compare comp = {}, Proj proj = {}) const {
+        return static_cast<size_t>(std::ranges::lower_bound(begin(), end(), key, comp, proj) - begin());
+    }
+
+    template<typename Key, typename Compare = std::ranges::less, typename Proj = std::identity>
+    size_t upper_bound(const Key& key, Compare comp = {}, Proj proj = {}) const {
+        return static_cast<size_t>(std::ranges::upper_bound(begin(), end(), key, comp, proj) - begin());
+    }
+
+    // Полуинтервал индексов [first, second) элементов, равных key
+    template<typename Key, typename Compare = std::ranges::less, typename Proj = std::identity>
+    std::pair<size_t, size_t> equal_range(const Key& key, Compare comp = {}, Proj proj = {}) const {
+        auto range = std::ranges::equal_range(begin(), end(), key, comp, proj);
+        return {static_cast<size_t>(range.begin() - begin()), static_cast<size_t>(range.end() - begin())};
+    }
+
+    void resize(size_t new_size) {
+        resize_impl(new_size);
+    }
+
+    void resize(size_t new_size, const T& value) {
+        resize_impl(new_size, value);
+    }
+
+    void assign(size_t count, const T& value) {
+        clear();
+        resize_impl(count, value);
+    }
+
+    template<std::input_iterator InputIt, std::sentinel_for<InputIt> Sentinel>
+    void assign(InputIt first, Sentinel last) {
+        clear();
+        insert(0, first, last);
+    }
+
     Iterator begin() { 
         return Iterator(pointers);
     }
     Iterator end() { 
         return Iterator(pointers + vec_size);
     }
+    ConstIterator begin() const {
+        return ConstIterator(pointers);
+    }
+    ConstIterator end() const {
+        return ConstIterator(pointers + vec_size);
+    }
+    ConstIterator cbegin() const {
+        return begin();
+    }
+    ConstIterator cend() const {
+        return end();
+    }
+
+    ReverseIterator rbegin() {
+        return ReverseIterator(end());
+    }
+    ReverseIterator rend() {
+        return ReverseIterator(begin());
+    }
+    ConstReverseIterator rbegin() const {
+        return ConstReverseIterator(end());
+    }
+    ConstReverseIterator rend() const {
+        return ConstReverseIterator(begin());
+    }
+    ConstReverseIterator crbegin() const {
+        return rbegin();
+    }
+    ConstReverseIterator crend() const {
+        return rend();
+    }
+
+    // Обход без надгробий
+    auto live() {
+        return std::ranges::subrange(LiveIter(pointers, pointers + vec_size), LiveIter(pointers + vec_size, pointers + vec_size));
+    }
+
+    auto live() const {
+        return std::ranges::subrange(ConstLiveIter(pointers, pointers + vec_size),
+                                     ConstLiveIter(pointers + vec_size, pointers + vec_size));
+    }
 };
 } // namespace my_vector
@@ -0,0 +1,294 @@
+#pragma once
+#include "vector.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <new>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace my_vector {
+
+// === Бинарный снимок PmrVector: save/load ===
+// Формат: заголовок (magic, версия, вид раскладки, размер элемента, число элементов),
+// затем элементы и в конце контрольная сумма FNV-1a по элементам.
+// Тривиально копируемые T пишутся побайтно одним проходом, остальные - через
+// Serializer<T> (для строк есть готовая специализация с префиксом длины).
+
+// Запись в поток с подсчётом контрольной суммы
+class SnapshotWriter {
+public:
+    explicit SnapshotWriter(std::ostream& stream) : os(stream) {}
+
+    void write(const void* data, size_t bytes) {
+        hash_bytes(data, bytes);
+        os.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+        if (!os) {
+            throw std::runtime_error("snapshot write failed");
+        }
+    }
+
+    template<typename U>
+    void write_value(const U& value) {
+        static_assert(std::is_trivially_copyable_v<U>);
+        write(&value, sizeof(U));
+    }
+
+    uint64_t checksum() const noexcept {
+        return hash;
+    }
+
+private:
+    std::ostream& os;
+    uint64_t hash = 0xcbf29ce484222325ull;
+
+    void hash_bytes(const void* data, size_t bytes) noexcept {
+        auto* p = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < bytes; ++i) {
+            hash = (hash ^ p[i]) * 0x100000001b3ull;
+        }
+    }
+
+    friend class SnapshotReader;
+};
+
+// Чтение из потока с подсчётом контрольной суммы; короткое чтение - исключение
+class SnapshotReader {
+public:
+    explicit SnapshotReader(std::istream& stream) : is(stream) {}
+
+    void read(void* data, size_t bytes) {
+        is.read(static_cast<char*>(data), static_cast<std::streamsize>(bytes));
+        if (static_cast<size_t>(is.gcount()) != bytes) {
+            throw std::runtime_error("snapshot is truncated");
+        }
+        auto* p = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < bytes; ++i) {
+            hash = (hash ^ p[i]) * 0x100000001b3ull;
+        }
+    }
+
+    template<typename U>
+    U read_value() {
+        static_assert(std::is_trivially_copyable_v<U>);
+        U value;
+        read(&value, sizeof(U));
+        return value;
+    }
+
+    // Сколько байт осталось в потоке; для потока без позиционирования - SIZE_MAX.
+    // Длины и счётчики из файла стоит сверять с этим значением до выделения памяти
+    size_t remaining() {
+        std::istream::pos_type here = is.tellg();
+        if (here == std::istream::pos_type(-1)) {
+            return SIZE_MAX;
+        }
+        is.seekg(0, std::ios::end);
+        std::istream::pos_type end = is.tellg();
+        is.seekg(here);
+        if (end == std::istream::pos_type(-1) || end < here) {
+            return SIZE_MAX;
+        }
+        return static_cast<size_t>(end - here);
+    }
+
+    uint64_t checksum() const noexcept {
+        return hash;
+    }
+
+private:
+    std::istream& is;
+    uint64_t hash = 0xcbf29ce484222325ull;
+};
+
+// Точка расширения для не тривиально копируемых типов:
+//   static void write(SnapshotWriter&, const T&);
+//   template<typename Emplace> static void read(SnapshotReader&, Emplace&& emplace);
+// read вызывает emplace(args...) - элемент конструируется прямо в векторе,
+// аллокатор вектора передаётся аллокатор-зависимым полям автоматически.
+// Префиксам длины из файла доверять нельзя - см. SnapshotReader::remaining()
+template<typename T, typename = void>
+struct Serializer;
+
+template<typename Char, typename Traits, typename Alloc>
+struct Serializer<std::basic_string<Char, Traits, Alloc>> {
+    static void write(SnapshotWriter& out, const std::basic_string<Char, Traits, Alloc>& value) {
+        out.write_value<uint64_t>(value.size());
+        out.write(value.data(), value.size() * sizeof(Char));
+    }
+
+    template<typename Emplace>
+    static void read(SnapshotReader& in, Emplace&& emplace) {
+        thread_local std::basic_string<Char, Traits> buffer;
+        // длине из файла не доверяем: буфер растёт по мере чтения, обрыв потока - исключение
+        uint64_t length = in.read_value<uint64_t>();
+        buffer.clear();
+        while (buffer.size() < length) {
+            size_t done = buffer.size();
+            size_t piece = static_cast<size_t>(std::min<uint64_t>(length - done, 4096));
+            buffer.resize(done + piece);
+            in.read(buffer.data() + done, piece * sizeof(Char));
+        }
+        emplace(std::basic_string_view<Char, Traits>(buffer));
+    }
+};
+
+namespace snapshot_detail {
+
+constexpr uint64_t kMagic = 0x50414E5356524D50ull; // "PMRVSNAP"
+constexpr uint32_t kVersion = 1;
+constexpr uint32_t kTrivialLayout = 1;
+constexpr uint32_t kSerializedLayout = 2;
+constexpr size_t kBufferBytes = 64 * 1024;
+
+struct Header {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t layout;
+    uint64_t element_size;
+    uint64_t count;
+};
+
+template<typename T>
+constexpr uint32_t layout_of() {
+    return std::is_trivially_copyable_v<T> ? kTrivialLayout : kSerializedLayout;
+}
+
+// Сколько элементов стоит зарезервировать заранее: счётчику из заголовка не доверяем.
+// Для потока с позиционированием - не больше, чем помещается в оставшиеся байты
+// (каждый элемент занимает минимум min_bytes), иначе - не больше одного буфера;
+// остальное вектор добирает ростом по мере чтения
+inline uint64_t reserve_hint(std::istream& is, uint64_t count, size_t min_bytes) {
+    uint64_t limit = kBufferBytes / min_bytes;
+    std::istream::pos_type here = is.tellg();
+    if (here != std::istream::pos_type(-1)) {
+        is.seekg(0, std::ios::end);
+        std::istream::pos_type end = is.tellg();
+        is.seekg(here);
+        if (end != std::istream::pos_type(-1) && end >= here) {
+            limit = static_cast<uint64_t>(end - here) / min_bytes;
+        }
+    }
+    return std::min(count, limit);
+}
+
+} // namespace snapshot_detail
+
+// Надгробия (mark_erased) в снимок не попадают
+template<typename T, size_t N>
+void save(const PmrVector<T, N>& vec, std::ostream& os) {
+    using namespace snapshot_detail;
+    Header header{kMagic, kVersion, layout_of<T>(), sizeof(T), vec.live_size()};
+    os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    SnapshotWriter out(os);
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        // элементы лежат в разных слотах - собираем их в буфер и пишем крупными блоками
+        std::vector<std::byte> buffer(std::max<size_t>(kBufferBytes / sizeof(T), 1) * sizeof(T));
+        size_t used = 0;
+        for (const T& value : vec.live()) {
+            std::memcpy(buffer.data() + used, &value, sizeof(T));
+            used += sizeof(T);
+            if (used == buffer.size()) {
+                out.write(buffer.data(), used);
+                used = 0;
+            }
+        }
+        out.write(buffer.data(), used);
+    } else {
+        for (const T& value : vec.live()) {
+            Serializer<T>::write(out, value);
+        }
+    }
+
+    uint64_t checksum = out.checksum();
+    os.write(reinterpret_cast<const char*>(&checksum), sizeof(checksum));
+    if (!os) {
+        throw std::runtime_error("snapshot write failed");
+    }
+}
+
+// Заменяет содержимое вектора элементами из снимка. Элементы читаются во временный
+// вектор на том же ресурсе и переносятся в vec только после проверки контрольной суммы:
+// при ошибке содержимое vec не меняется
+template<typename T, size_t N>
+void load(PmrVector<T, N>& vec, std::istream& is) {
+    using namespace snapshot_detail;
+    Header header{};
+    is.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (static_cast<size_t>(is.gcount()) != sizeof(header) || header.magic != kMagic) {
+        throw std::runtime_error("not a PmrVector snapshot");
+    }
+    if (header.version != kVersion) {
+        throw std::runtime_error("unsupported snapshot version");
+    }
+    if (header.layout != layout_of<T>() || header.element_size != sizeof(T)) {
+        throw std::runtime_error("snapshot element type mismatch");
+    }
+
+    constexpr size_t min_bytes = std::is_trivially_copyable_v<T> ? sizeof(T) : 1;
+    PmrVector<T, N> loaded(vec.get_resource());
+    loaded.reserve(reserve_hint(is, header.count, min_bytes));
+
+    SnapshotReader in(is);
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        std::vector<std::byte> buffer(std::max<size_t>(kBufferBytes / sizeof(T), 1) * sizeof(T));
+        size_t left = header.count;
+        while (left > 0) {
+            size_t batch = std::min(left, buffer.size() / sizeof(T));
+            in.read(buffer.data(), batch * sizeof(T));
+            for (size_t i = 0; i < batch; ++i) {
+                // memcpy неявно создаёт объект тривиально копируемого T - конструктор
+                // по умолчанию не нужен; отдельное хранилище - ради выравнивания T
+                alignas(T) std::byte raw[sizeof(T)];
+                std::memcpy(raw, buffer.data() + i * sizeof(T), sizeof(T));
+                loaded.push_back(std::move(*std::launder(reinterpret_cast<T*>(raw))));
+            }
+            left -= batch;
+        }
+    } else {
+        auto emplace = [&loaded](auto&&... args) {
+            loaded.emplace_back(std::forward<decltype(args)>(args)...);
+        };
+        for (uint64_t i = 0; i < header.count; ++i) {
+            Serializer<T>::read(in, emplace);
+        }
+    }
+
+    uint64_t expected = 0;
+    is.read(reinterpret_cast<char*>(&expected), sizeof(expected));
+    if (static_cast<size_t>(is.gcount()) != sizeof(expected)) {
+        throw std::runtime_error("snapshot is truncated");
+    }
+    if (expected != in.checksum()) {
+        throw std::runtime_error("snapshot checksum mismatch");
+    }
+    vec = std::move(loaded);
+}
+
+template<typename T, size_t N>
+void save(const PmrVector<T, N>& vec, const std::string& path) {
+    std::ofstream os(path, std::ios::binary | std::ios::trunc);
+    if (!os) {
+        throw std::runtime_error("cannot open " + path);
+    }
+    save(vec, os);
+}
+
+template<typename T, size_t N>
+void load(PmrVector<T, N>& vec, const std::string& path) {
+    std::ifstream is(path, std::ios::binary);
+    if (!is) {
+        throw std::runtime_error("cannot open " + path);
+    }
+    load(vec, is);
+}
+
+} // namespace my_vector
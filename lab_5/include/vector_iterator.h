@@ -1,26 +1,40 @@
 #pragma once
 #include <cstddef>
+#include <compare>
 #include <iterator>
+#include <type_traits>
 
 namespace my_vector {
 
 // === 5. Реализация итератора к созданному контейнеру (дин. массив) ===
-// === Итератор соответствует std::forward_iterator_tag ===
-template<typename T>
+// === Итератор произвольного доступа (std::random_access_iterator) ===
+// IsConst = true - константный итератор, элементы доступны только для чтения
+template<typename T, bool IsConst = false>
 class VectorIterator {
 private:
     // Итератор хранит позицию внутри динамического массива
     // Храним указатель на указатель - элемент хранится как T*
-    T** current; 
+    using table_pointer = std::conditional_t<IsConst, T* const*, T**>;
+    table_pointer current = nullptr;
+
+    template<typename, bool>
+    friend class VectorIterator;
 
 public:
-    using iterator_category = std::forward_iterator_tag;
-    using value_type = T;
+    using iterator_category = std::random_access_iterator_tag;
+    using iterator_concept = std::random_access_iterator_tag;
+    using value_type = std::remove_const_t<T>;
     using difference_type = std::ptrdiff_t;
-    using pointer = T*;
-    using reference = T&;
+    using pointer = std::conditional_t<IsConst, const T*, T*>;
+    using reference = std::conditional_t<IsConst, const T&, T&>;
+
+    VectorIterator() = default;
+
+    explicit VectorIterator(table_pointer ptr) : current(ptr) {}
 
-    explicit VectorIterator(T** ptr) : current(ptr) {}
+    // Неконстантный итератор неявно приводится к константному
+    template<bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+    VectorIterator(const VectorIterator<T, OtherConst>& other) : current(other.current) {}
 
     // Разыменование итератора
     reference operator*() const {
@@ -31,6 +45,10 @@ public:
         return *current; // возвращаем указатель на объект
     }
 
+    reference operator[](difference_type n) const {
+        return *current[n];
+    }
+
     // Инкрементирование итератора
     // ++it
     VectorIterator& operator++() {
@@ -45,14 +63,112 @@ public:
         return temp;
     }
 
+    // Декрементирование итератора
+    VectorIterator& operator--() {
+        --current;
+        return *this;
+    }
+
+    VectorIterator operator--(int) {
+        VectorIterator temp = *this;
+        --(*this);
+        return temp;
+    }
+
+    // Арифметика произвольного доступа
+    VectorIterator& operator+=(difference_type n) {
+        current += n;
+        return *this;
+    }
+
+    VectorIterator& operator-=(difference_type n) {
+        current -= n;
+        return *this;
+    }
+
+    friend VectorIterator operator+(VectorIterator it, difference_type n) {
+        return it += n;
+    }
+
+    friend VectorIterator operator+(difference_type n, VectorIterator it) {
+        return it += n;
+    }
+
+    friend VectorIterator operator-(VectorIterator it, difference_type n) {
+        return it -= n;
+    }
+
+    friend difference_type operator-(const VectorIterator& lhs, const VectorIterator& rhs) {
+        return lhs.current - rhs.current;
+    }
+
     // Сравнение итераторов
     bool operator==(const VectorIterator& other) const {
         return current == other.current;
     }
 
-    bool operator!=(const VectorIterator& other) const {
-        return current != other.current;
+    auto operator<=>(const VectorIterator& other) const {
+        return current <=> other.current;
+    }
+};
+
+static_assert(std::random_access_iterator<VectorIterator<int>>);
+static_assert(std::random_access_iterator<VectorIterator<int, true>>);
+
+// === Итератор по живым элементам: пропускает надгробия (nullptr в таблице указателей) ===
+template<typename T, bool IsConst = false>
+class LiveIterator {
+private:
+    using table_pointer = std::conditional_t<IsConst, T* const*, T**>;
+    table_pointer current = nullptr;
+    table_pointer last = nullptr;
+
+    void skip_tombstones() {
+        while (current != last && *current == nullptr) {
+            ++current;
+        }
+    }
+
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using iterator_concept = std::forward_iterator_tag;
+    using value_type = std::remove_const_t<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<IsConst, const T*, T*>;
+    using reference = std::conditional_t<IsConst, const T&, T&>;
+
+    LiveIterator() = default;
+
+    LiveIterator(table_pointer ptr, table_pointer end) : current(ptr), last(end) {
+        skip_tombstones();
+    }
+
+    reference operator*() const {
+        return **current;
+    }
+
+    pointer operator->() const {
+        return *current;
+    }
+
+    LiveIterator& operator++() {
+        ++current;
+        skip_tombstones();
+        return *this;
+    }
+
+    LiveIterator operator++(int) {
+        LiveIterator temp = *this;
+        ++(*this);
+        return temp;
+    }
+
+    bool operator==(const LiveIterator& other) const {
+        return current == other.current;
     }
 };
 
+static_assert(std::forward_iterator<LiveIterator<int>>);
+static_assert(std::forward_iterator<LiveIterator<int, true>>);
+
 } // namespace my_vector
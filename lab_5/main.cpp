@@ -1,5 +1,6 @@
 #include "include/vector.h"
 #include "include/vector_iterator.h"
+#include "include/recording_resource.h"
 #include <iostream>
 #include <string>
 #include <cstddef>
@@ -103,12 +104,25 @@ void demonstrate_exception_handling() {
     std::cout << "Front: " << vec.front() << ", Back: " << vec.back() << std::endl << std::endl;
 }
 
-int main() {
+// ./lab5_exe --record trace.bin - записать аллокации демонстрации для ./replay
+int main(int argc, char** argv) {
         
     try {
+        std::string record_path = (argc == 3 && std::string(argv[1]) == "--record") ? argv[2] : "";
+        my_vector::RecordingResource recorder;
+        if (!record_path.empty()) {
+            std::pmr::set_default_resource(&recorder);
+        }
+
         demonstrate_simple_types();
         demonstrate_complex_types();
         demonstrate_exception_handling();
+
+        if (!record_path.empty()) {
+            std::pmr::set_default_resource(nullptr);
+            recorder.save(record_path);
+            std::cout << "Трасса аллокаций записана в " << record_path << std::endl;
+        }
         
         std::cout << "===================================" << std::endl;
         std::cout << "ВСЕ ДЕМОНСТРАЦИИ ЗАВЕРШИЛИСЬ УСПЕШНО!" << std::endl;
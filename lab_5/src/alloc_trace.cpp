@@ -0,0 +1,139 @@
+#include "../include/alloc_trace.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace my_vector {
+
+namespace {
+
+uint64_t now_ns() noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+std::ofstream open_output(const std::string& path) {
+    std::ofstream out(path);
+    if (!out) {
+        throw std::runtime_error("cannot open trace file " + path);
+    }
+    return out;
+}
+
+} // namespace
+
+const char* to_string(TraceOp op) noexcept {
+    switch (op) {
+        case TraceOp::Allocate: return "allocate";
+        case TraceOp::Reuse: return "reuse";
+        case TraceOp::Deallocate: return "deallocate";
+        case TraceOp::Cleanup: return "cleanup";
+    }
+    return "unknown";
+}
+
+AllocTrace::AllocTrace(size_t capacity)
+    : slots(new Slot[std::bit_ceil(std::max<size_t>(capacity, 2))]),
+      mask(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1) {}
+
+void AllocTrace::record(TraceOp op, const void* ptr, size_t size, size_t alignment) noexcept {
+    uint64_t pos = head.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = slots[pos & mask];
+
+    TraceEvent event{now_ns(), ptr, size, static_cast<uint32_t>(alignment), op};
+    uint64_t words[kEventWords];
+    std::memcpy(words, &event, sizeof(event));
+
+    slot.seq.store(2 * pos + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < kEventWords; ++i) {
+        slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+    slot.seq.store(2 * pos + 2, std::memory_order_release);
+}
+
+size_t AllocTrace::drain(std::vector<TraceEvent>& out) {
+    uint64_t end = head.load(std::memory_order_acquire);
+    if (end - tail > capacity()) {
+        lost += end - tail - capacity();
+        tail = end - capacity();
+    }
+
+    size_t taken = 0;
+    for (; tail < end; ++tail) {
+        Slot& slot = slots[tail & mask];
+        uint64_t before = slot.seq.load(std::memory_order_acquire);
+        if (before < 2 * tail + 2) {
+            break; // событие ещё пишется - заберём при следующем вызове
+        }
+        // слово за словом через атомики: запись может идти параллельно, гонки по данным нет
+        uint64_t words[kEventWords];
+        for (size_t i = 0; i < kEventWords; ++i) {
+            words[i] = slot.words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (before != 2 * tail + 2 || slot.seq.load(std::memory_order_relaxed) != before) {
+            ++lost; // слот уже перезаписан более новым событием
+            continue;
+        }
+        TraceEvent event;
+        std::memcpy(&event, words, sizeof(event));
+        out.push_back(event);
+        ++taken;
+    }
+    return taken;
+}
+
+void AllocTrace::dump_text(std::ostream& os) {
+    std::vector<TraceEvent> events;
+    drain(events);
+    for (const TraceEvent& e : events) {
+        os << e.timestamp_ns << ' ' << to_string(e.op) << ' ' << e.ptr
+           << " size=" << e.size << " align=" << e.alignment << '\n';
+    }
+}
+
+void AllocTrace::dump_chrome_json(std::ostream& os) {
+    std::vector<TraceEvent> events;
+    drain(events);
+
+    // Мгновенные события для каждой операции и счётчик занятых байт
+    os << "{\"traceEvents\":[";
+    int64_t live_bytes = 0;
+    bool first = true;
+    for (const TraceEvent& e : events) {
+        if (e.op == TraceOp::Allocate || e.op == TraceOp::Reuse) {
+            live_bytes += static_cast<int64_t>(e.size);
+        } else if (e.op == TraceOp::Deallocate) {
+            live_bytes -= static_cast<int64_t>(e.size);
+        }
+        // микросекунды с тремя знаками после точки: double с точностью потока по умолчанию
+        // (6 значащих цифр) склеивал бы события уже после первой секунды
+        std::string ts_us = std::to_string(e.timestamp_ns / 1000) + '.' +
+                            std::to_string(1000 + e.timestamp_ns % 1000).substr(1);
+
+        os << (first ? "" : ",") << "\n{\"name\":\"" << to_string(e.op)
+           << "\",\"ph\":\"i\",\"s\":\"p\",\"pid\":0,\"tid\":0,\"ts\":" << ts_us
+           << ",\"args\":{\"ptr\":\"" << e.ptr << "\",\"size\":" << e.size
+           << ",\"alignment\":" << e.alignment << "}}";
+        os << ",\n{\"name\":\"live_bytes\",\"ph\":\"C\",\"pid\":0,\"ts\":" << ts_us
+           << ",\"args\":{\"bytes\":" << live_bytes << "}}";
+        first = false;
+    }
+    os << "\n]}\n";
+}
+
+void AllocTrace::dump_text(const std::string& path) {
+    std::ofstream out = open_output(path);
+    dump_text(out);
+}
+
+void AllocTrace::dump_chrome_json(const std::string& path) {
+    std::ofstream out = open_output(path);
+    dump_chrome_json(out);
+}
+
+} // namespace my_vector
@@ -0,0 +1,269 @@
+#include "../include/concurrent_memory_resource.h"
+#include <cstdlib>
+#include <algorithm>
+#include <bit>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+namespace my_vector {
+
+namespace {
+
+std::atomic<uint64_t> next_resource_id{1};
+
+// Последние кэши, к которым обращался поток: (id ресурса, кэш).
+// Ресурсы получают неповторяющиеся id, поэтому записи уничтоженных ресурсов просто не совпадут
+struct CacheSlot {
+    uint64_t owner = 0;
+    void* cache = nullptr;
+};
+constexpr size_t kRecentCaches = 4;
+thread_local std::array<CacheSlot, kRecentCaches> recent_caches;
+thread_local size_t recent_next = 0;
+// Список кэшей потока уже уничтожен (поток завершается): дальнейшие вызовы из деструкторов
+// других thread_local-объектов идут мимо кэша, прямо в общий пул
+thread_local bool caches_released = false;
+
+} // namespace
+
+// === Возврат кэшей при завершении потока ===
+// Реестр живых ресурсов по id и thread_local-список кэшей потока. Деструктор списка
+// (при выходе из потока) под мьютексом реестра отдаёт кэши ещё живым ресурсам;
+// ресурс снимается с учёта под тем же мьютексом, поэтому не исчезнет посреди возврата.
+// Реестр не уничтожается: статические ресурсы могут пережить статику этого файла
+struct ThreadCacheRegistry {
+    std::mutex mutex;
+    std::unordered_map<uint64_t, ConcurrentListMemoryResource*> resources;
+
+    static ThreadCacheRegistry& instance() {
+        static ThreadCacheRegistry* registry = new ThreadCacheRegistry();
+        return *registry;
+    }
+
+    struct ThreadCaches {
+        std::vector<CacheSlot> owned;
+
+        ~ThreadCaches() {
+            ThreadCacheRegistry& registry = instance();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            for (const CacheSlot& slot : owned) {
+                if (auto it = registry.resources.find(slot.owner); it != registry.resources.end()) {
+                    it->second->release_cache(static_cast<ConcurrentListMemoryResource::ThreadCache*>(slot.cache));
+                }
+            }
+            owned.clear();
+            recent_caches.fill({});
+            recent_next = 0;
+            caches_released = true;
+        }
+
+        // Кэш потока для ресурса или nullptr; заодно забывает кэши уничтоженных ресурсов
+        void* find(uint64_t owner) {
+            for (const CacheSlot& slot : owned) {
+                if (slot.owner == owner) {
+                    return slot.cache;
+                }
+            }
+            ThreadCacheRegistry& registry = instance();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            std::erase_if(owned, [&](const CacheSlot& slot) { return !registry.resources.contains(slot.owner); });
+            return nullptr;
+        }
+    };
+};
+
+namespace {
+thread_local ThreadCacheRegistry::ThreadCaches thread_caches;
+} // namespace
+
+ConcurrentListMemoryResource::ConcurrentListMemoryResource()
+    : id(next_resource_id.fetch_add(1, std::memory_order_relaxed)) {
+    ThreadCacheRegistry& registry = ThreadCacheRegistry::instance();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.resources.emplace(id, this);
+}
+
+// Деструктор: вся память выделялась кусками, освобождаем их целиком
+ConcurrentListMemoryResource::~ConcurrentListMemoryResource() {
+    {
+        ThreadCacheRegistry& registry = ThreadCacheRegistry::instance();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.resources.erase(id);
+    }
+    for (const Chunk& chunk : chunks) {
+        std::free(chunk.ptr);
+    }
+}
+
+size_t ConcurrentListMemoryResource::size_class(size_t bytes, size_t alignment) {
+    size_t need = std::max({bytes, alignment, size_t{1} << kMinSizeClass});
+    size_t cls = static_cast<size_t>(std::bit_width(need - 1));
+    if (cls >= kSizeClasses) {
+        throw std::bad_alloc(); // больше 2^63 байт
+    }
+    return cls;
+}
+
+size_t ConcurrentListMemoryResource::batch_size(size_t cls) noexcept {
+    return std::clamp<size_t>(kBatchBytes >> std::min<size_t>(cls, 63), 1, kMaxBatch);
+}
+
+// nullptr - поток завершается и его кэши уже возвращены
+ConcurrentListMemoryResource::ThreadCache* ConcurrentListMemoryResource::local_cache() {
+    for (const CacheSlot& slot : recent_caches) {
+        if (slot.owner == id) {
+            return static_cast<ThreadCache*>(slot.cache);
+        }
+    }
+    if (caches_released) {
+        return nullptr;
+    }
+
+    auto* cache = static_cast<ThreadCache*>(thread_caches.find(id));
+    if (!cache) {
+        auto fresh = std::make_unique<ThreadCache>();
+        thread_caches.owned.reserve(thread_caches.owned.size() + 1);
+        {
+            std::lock_guard<std::mutex> lock(central_mutex);
+            caches.push_back(std::move(fresh));
+            cache = caches.back().get();
+        }
+        thread_caches.owned.push_back({id, cache});
+    }
+    recent_caches[recent_next] = {id, cache};
+    recent_next = (recent_next + 1) % kRecentCaches;
+    return cache;
+}
+
+// Пополнение кэша потока пачкой блоков из общего пула или из нового куска памяти.
+// Блоки size-класса k нарезаются с шагом 2^k от куска, выровненного на 2^k, -
+// поэтому каждый блок выровнен на свой размер
+void ConcurrentListMemoryResource::refill(FreeList& bin, size_t cls) {
+    size_t batch = batch_size(cls);
+    std::lock_guard<std::mutex> lock(central_mutex);
+
+    FreeList& central = central_bins[cls];
+    while (central.count > 0 && bin.count < batch) {
+        bin.push(central.pop());
+    }
+    if (bin.count > 0) {
+        return;
+    }
+
+    size_t block_size = size_t{1} << cls;
+    size_t chunk_size = block_size * batch;
+    void* ptr = std::aligned_alloc(block_size, chunk_size);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    try {
+        chunks.push_back({ptr, chunk_size, block_size});
+    } catch (...) {
+        std::free(ptr);
+        throw;
+    }
+
+    auto* bytes = static_cast<std::byte*>(ptr);
+    for (size_t i = batch; i-- > 0;) {
+        bin.push(reinterpret_cast<FreeNode*>(bytes + i * block_size));
+    }
+}
+
+// Сброс излишков кэша потока в общий пул, где их подберут другие потоки
+void ConcurrentListMemoryResource::flush(FreeList& bin, size_t cls, size_t keep) {
+    std::lock_guard<std::mutex> lock(central_mutex);
+    FreeList& central = central_bins[cls];
+    while (bin.count > keep) {
+        central.push(bin.pop());
+    }
+}
+
+// Кэш завершившегося потока: блоки - в общий пул, сам кэш удаляется
+void ConcurrentListMemoryResource::release_cache(ThreadCache* cache) noexcept {
+    std::lock_guard<std::mutex> lock(central_mutex);
+    for (size_t cls = 0; cls < kSizeClasses; ++cls) {
+        FreeList& bin = cache->bins[cls];
+        while (bin.count > 0) {
+            central_bins[cls].push(bin.pop());
+        }
+    }
+    auto it = std::find_if(caches.begin(), caches.end(), [cache](const auto& entry) { return entry.get() == cache; });
+    if (it != caches.end()) {
+        std::swap(*it, caches.back());
+        caches.pop_back();
+    }
+}
+
+size_t ConcurrentListMemoryResource::free_bytes() {
+    std::lock_guard<std::mutex> lock(central_mutex);
+    size_t total = 0;
+    for (size_t cls = 0; cls < kSizeClasses; ++cls) {
+        total += central_bins[cls].count << cls;
+    }
+    return total;
+}
+
+size_t ConcurrentListMemoryResource::reserved_bytes() {
+    std::lock_guard<std::mutex> lock(central_mutex);
+    size_t total = 0;
+    for (const Chunk& chunk : chunks) {
+        total += chunk.size;
+    }
+    return total;
+}
+
+void ConcurrentListMemoryResource::flush_thread_cache() {
+    ThreadCache* cache = local_cache();
+    if (!cache) {
+        return;
+    }
+    for (size_t cls = 0; cls < kSizeClasses; ++cls) {
+        if (cache->bins[cls].count > 0) {
+            flush(cache->bins[cls], cls, 0);
+        }
+    }
+}
+
+void* ConcurrentListMemoryResource::do_allocate(size_t bytes, size_t alignment) {
+    size_t cls = size_class(bytes, alignment);
+    ThreadCache* cache = local_cache();
+    if (!cache) {
+        // без кэша: берём пачку, один блок оставляем себе, остальное сразу возвращаем
+        FreeList batch;
+        refill(batch, cls);
+        void* p = batch.pop();
+        flush(batch, cls, 0);
+        return p;
+    }
+    FreeList& bin = cache->bins[cls];
+    if (bin.count == 0) {
+        refill(bin, cls);
+    }
+    return bin.pop();
+}
+
+void ConcurrentListMemoryResource::do_deallocate(void* ptr, size_t bytes, size_t alignment) {
+    size_t cls = size_class(bytes, alignment);
+    ThreadCache* cache = local_cache();
+    if (!cache) {
+        std::lock_guard<std::mutex> lock(central_mutex);
+        central_bins[cls].push(static_cast<FreeNode*>(ptr));
+        return;
+    }
+    FreeList& bin = cache->bins[cls];
+    bin.push(static_cast<FreeNode*>(ptr));
+
+    // Кэш не растёт бесконечно: всё сверх одной пачки отдаём в общий пул
+    size_t batch = batch_size(cls);
+    if (bin.count > 2 * batch) {
+        flush(bin, cls, batch);
+    }
+}
+
+bool ConcurrentListMemoryResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+} // namespace my_vector
@@ -0,0 +1,117 @@
+#include "../include/mapped_file.h"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace my_vector {
+
+namespace {
+
+[[noreturn]] void throw_errno(const std::string& what, const std::string& path) {
+    throw std::runtime_error(what + " '" + path + "': " + std::strerror(errno));
+}
+
+} // namespace
+
+MappedFile::MappedFile(const std::string& path) : file_path(path) {
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        throw_errno("cannot open", path);
+    }
+
+    struct stat st{};
+    if (::fstat(fd, &st) != 0) {
+        int saved = errno;
+        ::close(fd);
+        errno = saved;
+        throw_errno("cannot stat", path);
+    }
+    try {
+        map(static_cast<size_t>(st.st_size));
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+}
+
+MappedFile::~MappedFile() {
+    unmap();
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+void MappedFile::map(size_t size) {
+    mapped_size = size;
+    if (size == 0) {
+        mapping = nullptr; // пустой файл отобразить нельзя
+        return;
+    }
+    void* ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (ptr == MAP_FAILED) {
+        mapped_size = 0;
+        throw_errno("cannot mmap", file_path);
+    }
+    mapping = static_cast<std::byte*>(ptr);
+}
+
+void MappedFile::unmap() noexcept {
+    if (mapping) {
+        ::munmap(mapping, mapped_size);
+        mapping = nullptr;
+    }
+    mapped_size = 0;
+}
+
+// Старое отображение живёт, пока новое не создано: при любой ошибке объект остаётся
+// с прежними размером и адресом, а размер файла откатывается
+void MappedFile::resize(size_t new_size) {
+    if (new_size == mapped_size) {
+        return;
+    }
+    size_t old_size = mapped_size;
+    bool growing = new_size > old_size;
+    if (growing && ::ftruncate(fd, static_cast<off_t>(new_size)) != 0) {
+        throw_errno("cannot resize", file_path);
+    }
+
+    std::byte* fresh = nullptr;
+    if (new_size > 0) {
+        void* ptr = ::mmap(nullptr, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (ptr == MAP_FAILED) {
+            int saved = errno;
+            if (growing && ::ftruncate(fd, static_cast<off_t>(old_size)) != 0) {
+                // откатить размер не удалось - файл длиннее, но отображение прежнее
+            }
+            errno = saved;
+            throw_errno("cannot mmap", file_path);
+        }
+        fresh = static_cast<std::byte*>(ptr);
+    }
+
+    // укорачиваем файл только когда новое отображение уже есть
+    if (!growing && ::ftruncate(fd, static_cast<off_t>(new_size)) != 0) {
+        int saved = errno;
+        if (fresh) {
+            ::munmap(fresh, new_size);
+        }
+        errno = saved;
+        throw_errno("cannot resize", file_path);
+    }
+
+    unmap();
+    mapping = fresh;
+    mapped_size = new_size;
+}
+
+void MappedFile::sync() {
+    if (mapping && ::msync(mapping, mapped_size, MS_SYNC) != 0) {
+        throw_errno("cannot msync", file_path);
+    }
+}
+
+} // namespace my_vector
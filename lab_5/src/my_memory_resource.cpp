@@ -1,56 +1,450 @@
 #include "../include/my_memory_resource.h"
-#include <cstdlib>
 #include <algorithm>
+#include <bit>
+#include <iterator>
 #include <stdexcept>
-#include <iostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#define MY_VECTOR_HAS_MMAP 1
+#endif
 
 namespace my_vector {
 
-// Деструктор: освобождает все блоки памяти 
+namespace {
+
+// Округление вверх до кратного step; если результат не помещается в size_t,
+// такой запрос заведомо не выполнить - bad_alloc вместо переполнения
+size_t round_up(size_t value, size_t step) {
+    if (value > SIZE_MAX - (step - 1)) {
+        throw std::bad_alloc();
+    }
+    return (value + step - 1) / step * step;
+}
+
+} // namespace
+
+ListMemoryResource::ListMemoryResource(std::pmr::memory_resource* upstream_resource)
+    : ListMemoryResource(ListMemoryResourceOptions{upstream_resource}) {}
+
+ListMemoryResource::ListMemoryResource(const ListMemoryResourceOptions& options)
+    : upstream(options.upstream ? options.upstream : std::pmr::get_default_resource()),
+      chunk_size(round_up(std::max(options.chunk_size, kGranularity), kGranularity)) {
+    if (options.arena_bytes > 0) {
+        reserve_arena(options);
+    }
+}
+
+// Деструктор: освобождает все куски памяти вместе с нарезанными из них блоками
 ListMemoryResource::~ListMemoryResource() {
-    for (const BlockInfo& block : blocks) {
-        std::free(block.ptr);
-        std::cout << "Cleaned up memory at " << block.ptr << " (size: " << block.size << " bytes)\n";
+    for (const ChunkInfo& chunk : chunks) {
+        if (chunk.ptr) {
+            free_chunk(chunk);
+        }
+    }
+}
+
+void ListMemoryResource::free_chunk(const ChunkInfo& chunk) noexcept {
+    MY_VECTOR_TRACE(trace, TraceOp::Cleanup, chunk.ptr, chunk.size, chunk.alignment);
+#ifdef MY_VECTOR_HAS_MMAP
+    if (chunk.kind == ChunkKind::MappedArena) {
+        munmap(chunk.ptr, chunk.size);
+        return;
     }
+#endif
+    upstream->deallocate(chunk.ptr, chunk.size, chunk.alignment);
+}
+
+// Арена берётся один раз в конструкторе и живёт до уничтожения ресурса
+void ListMemoryResource::reserve_arena(const ListMemoryResourceOptions& options) {
+    size_t size = round_up(options.arena_bytes, kGranularity);
+#ifdef MY_VECTOR_HAS_MMAP
+    if (options.arena_mmap) {
+        void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+#ifdef MADV_HUGEPAGE
+        if (options.arena_huge_pages) {
+            madvise(ptr, size, MADV_HUGEPAGE); // только подсказка ядру, ошибку можно игнорировать
+        }
+#endif
+        try {
+            register_chunk(ptr, size, kGranularity, ChunkKind::MappedArena);
+        } catch (...) {
+            munmap(ptr, size);
+            throw;
+        }
+        return;
+    }
+#endif
+    void* ptr = upstream->allocate(size, kGranularity);
+    try {
+        register_chunk(ptr, size, kGranularity, ChunkKind::Arena);
+    } catch (...) {
+        upstream->deallocate(ptr, size, kGranularity);
+        throw;
+    }
+}
+
+void ListMemoryResource::release() noexcept {
+    // арены переживают release() - запоминаем их, чтобы зарегистрировать заново
+    std::vector<ChunkInfo> arenas;
+    for (const ChunkInfo& chunk : chunks) {
+        if (!chunk.ptr) {
+            continue;
+        }
+        if (chunk.kind == ChunkKind::Upstream) {
+            free_chunk(chunk);
+        } else {
+            try {
+                arenas.push_back(chunk);
+            } catch (...) {
+                free_chunk(chunk);
+            }
+        }
+    }
+    chunks.clear();
     blocks.clear();
+    index.clear();
+    free_bins.fill(nullptr);
+    nonempty_bins = 0;
+    free_total = 0;
+    reserved_total = 0;
+
+    for (const ChunkInfo& arena : arenas) {
+        try {
+            register_chunk(arena.ptr, arena.size, arena.alignment, arena.kind);
+        } catch (...) {
+            free_chunk(arena);
+        }
+    }
 }
 
-void* ListMemoryResource::do_allocate(size_t bytes, size_t alignment) {
-    for (BlockInfo& block : blocks) {
-        // === 2. Повторное переиспользование ранее освобождённой памяти ===
-        if (!block.is_allocated && block.size >= bytes && block.alignment >= alignment) {
-            block.is_allocated = true;
-            std::cout << "REUSED memory at " << block.ptr << " for " << bytes << " bytes\n";
-            return block.ptr;
+void ListMemoryResource::warm_up(const CapacityProfile& profile) {
+    // Место под все указатели резервируем заранее, чтобы push_back не бросал между
+    // выделением блока и его учётом
+    size_t total = 0;
+    for (const CapacityProfileEntry& entry : profile) {
+        if (entry.count > SIZE_MAX - total) {
+            throw std::bad_alloc();
         }
+        total += entry.count;
     }
+    std::vector<BlockInfo*> prepared;
+    prepared.reserve(total);
 
-    // Выделение нового блока
-    void* ptr = std::aligned_alloc(alignment, bytes);
-    if (!ptr) { 
-        throw std::bad_alloc();
+    // Возвращаем блоки свободными, но без слияния - каждый остаётся готовым блоком своего размера.
+    // Кусок из одних таких блоков trim() всё равно распознаёт как свободный
+    auto release_prepared = [&]() noexcept {
+        for (BlockInfo* block : prepared) {
+            index.erase(block->ptr);
+            block->is_allocated = false;
+            --chunks[block->chunk].allocated_blocks;
+            block->ever_used = false;
+            push_free(block);
+        }
+    };
+
+    try {
+        for (const CapacityProfileEntry& entry : profile) {
+            for (size_t i = 0; i < entry.count; ++i) {
+                void* ptr = do_allocate(entry.bytes, kGranularity);
+                prepared.push_back(index.find(ptr)->second);
+            }
+        }
+    } catch (...) {
+        // уже нарезанные блоки не должны остаться занятыми навсегда
+        release_prepared();
+        throw;
+    }
+    release_prepared();
+}
+
+CapacityProfile ListMemoryResource::capacity_profile() const {
+    std::vector<size_t> sizes;
+    sizes.reserve(index.size());
+    for (const auto& [ptr, block] : index) {
+        sizes.push_back(block->size);
     }
+    std::sort(sizes.begin(), sizes.end());
 
-    blocks.push_back({ptr, bytes, alignment, true});
-    std::cout << "ALLOCATED new memory at " << ptr << " for " << bytes << " bytes\n";
-    return ptr;
+    CapacityProfile profile;
+    for (size_t size : sizes) {
+        if (profile.empty() || profile.back().bytes != size) {
+            profile.push_back({size, 0});
+        }
+        ++profile.back().count;
+    }
+    return profile;
 }
 
-// Освобождение памяти
-void ListMemoryResource::do_deallocate(void* ptr, size_t bytes, size_t alignment) {
-    auto it = std::find_if(
-        blocks.begin(),
-        blocks.end(),
-        [ptr](const BlockInfo& b) {
-            return b.ptr == ptr; 
-        });
-
-    if (it != blocks.end() && it->is_allocated) {
-        it->is_allocated = false;
-        std::cout << "DEALLOCATED memory at " << ptr << " (marked as free for reuse)\n";
+size_t ListMemoryResource::trim(size_t max_retained_bytes) noexcept {
+    if (free_total <= max_retained_bytes) {
+        return 0;
+    }
+
+    // Кусок пуст, если в нём нет занятых блоков - свободные могут быть и не слиты
+    // (например, после warm_up)
+    std::vector<size_t> empty_chunks;
+    try {
+        for (size_t id = 0; id < chunks.size(); ++id) {
+            const ChunkInfo& chunk = chunks[id];
+            if (chunk.ptr && chunk.kind == ChunkKind::Upstream && chunk.allocated_blocks == 0) {
+                empty_chunks.push_back(id);
+            }
+        }
+    } catch (...) {
+        // не хватило памяти на список кандидатов - освободим то, что успели собрать
+    }
+
+    // Сначала отдаём "холодные" куски - те, где освобождение было давнее всего
+    std::sort(empty_chunks.begin(), empty_chunks.end(), [this](size_t a, size_t b) {
+        return chunks[a].last_free < chunks[b].last_free;
+    });
+
+    size_t released = 0;
+    for (size_t id : empty_chunks) {
+        if (free_total <= max_retained_bytes) {
+            break;
+        }
+        ChunkInfo& chunk = chunks[id];
+        // блоки куска идут в списке подряд, начиная с head
+        auto it = chunk.head->self;
+        while (it != blocks.end() && it->chunk == id) {
+            unlink_free(&*it);
+            it = blocks.erase(it);
+        }
+
+        free_chunk(chunk);
+        reserved_total -= chunk.size;
+        released += chunk.size;
+        chunk.ptr = nullptr;
+        chunk.head = nullptr;
+    }
+    return released;
+}
+
+// Номер корзины: floor(log2(size))
+size_t ListMemoryResource::bin_of(size_t size) noexcept {
+    return static_cast<size_t>(std::bit_width(size)) - 1;
+}
+
+// Сколько байт нужно пропустить от начала блока, чтобы получить нужное выравнивание
+size_t ListMemoryResource::padding_for(const BlockInfo& block, size_t alignment) noexcept {
+    auto addr = reinterpret_cast<uintptr_t>(block.ptr);
+    return ((addr + alignment - 1) & ~(uintptr_t(alignment) - 1)) - addr;
+}
+
+void ListMemoryResource::push_free(BlockInfo* block) noexcept {
+    size_t bin = bin_of(block->size);
+    block->prev_free = nullptr;
+    block->next_free = free_bins[bin];
+    if (block->next_free) {
+        block->next_free->prev_free = block;
+    }
+    free_bins[bin] = block;
+    nonempty_bins |= uint64_t{1} << bin;
+    free_total += block->size;
+}
+
+void ListMemoryResource::unlink_free(BlockInfo* block) noexcept {
+    size_t bin = bin_of(block->size);
+    if (block->prev_free) {
+        block->prev_free->next_free = block->next_free;
     } else {
+        free_bins[bin] = block->next_free;
+    }
+    if (block->next_free) {
+        block->next_free->prev_free = block->prev_free;
+    }
+    block->next_free = block->prev_free = nullptr;
+    if (!free_bins[bin]) {
+        nonempty_bins &= ~(uint64_t{1} << bin);
+    }
+    free_total -= block->size;
+}
+
+// Good-fit: в корзине самого запроса блоки бывают и меньше него - среди первых
+// kBestFitScan выбираем наименьший подходящий. Любой блок из корзин старше подходит
+// по размеру, поэтому там берём первый из ближайшей непустой корзины.
+BlockInfo* ListMemoryResource::find_fit(size_t bytes, size_t alignment) noexcept {
+    size_t home = bin_of(bytes);
+
+    BlockInfo* best = nullptr;
+    size_t scanned = 0;
+    for (BlockInfo* block = free_bins[home]; block && scanned < kBestFitScan; block = block->next_free, ++scanned) {
+        size_t need = bytes + padding_for(*block, alignment);
+        if (block->size >= need && (!best || block->size < best->size)) {
+            best = block;
+            if (block->size == need) {
+                break;
+            }
+        }
+    }
+    if (best) {
+        return best;
+    }
+
+    uint64_t candidates = (home + 1 < kSizeClasses) ? nonempty_bins & (~uint64_t{0} << (home + 1)) : 0;
+    while (candidates) {
+        size_t bin = static_cast<size_t>(std::countr_zero(candidates));
+        candidates &= candidates - 1;
+        for (BlockInfo* block = free_bins[bin]; block; block = block->next_free) {
+            if (block->size >= bytes + padding_for(*block, alignment)) {
+                return block;
+            }
+        }
+    }
+    return nullptr;
+}
+
+// Новый кусок памяти у upstream; он целиком становится одним свободным блоком
+BlockInfo* ListMemoryResource::add_chunk(size_t bytes, size_t alignment) {
+    size_t chunk_alignment = std::max(alignment, kGranularity);
+    size_t size = round_up(std::max(bytes, chunk_size), chunk_alignment);
+
+    void* ptr = upstream->allocate(size, chunk_alignment);
+    try {
+        return register_chunk(ptr, size, chunk_alignment, ChunkKind::Upstream);
+    } catch (...) {
+        upstream->deallocate(ptr, size, chunk_alignment);
+        throw;
+    }
+}
+
+BlockInfo* ListMemoryResource::register_chunk(void* ptr, size_t size, size_t alignment, ChunkKind kind) {
+    // Запись куска, возвращённого через trim(), переиспользуется
+    auto hole = std::find_if(chunks.begin(), chunks.end(), [](const ChunkInfo& c) { return c.ptr == nullptr; });
+    size_t chunk_id = static_cast<size_t>(hole - chunks.begin());
+    if (hole == chunks.end()) {
+        chunks.push_back({nullptr, 0, 0});
+    }
+    blocks.push_back({ptr, size, kGranularity, false});
+    chunks[chunk_id] = {ptr, size, free_tick, alignment, kind};
+
+    BlockInfo* block = &blocks.back();
+    block->self = std::prev(blocks.end());
+    block->chunk = chunk_id;
+    chunks[chunk_id].head = block;
+    reserved_total += size;
+    push_free(block);
+    return block;
+}
+
+// Отделяет от блока хвост начиная с offset; хвост - новый свободный блок сразу за ним в списке
+BlockInfo* ListMemoryResource::split(BlockInfo* block, size_t offset) {
+    auto next = std::next(block->self);
+    auto it = blocks.insert(next, {static_cast<std::byte*>(block->ptr) + offset, block->size - offset, kGranularity, false});
+    it->self = it;
+    it->chunk = block->chunk;
+    it->ever_used = false; // хвост ещё не выдавался, его переиспользованием не считаем
+    block->size = offset;
+    return &*it;
+}
+
+// Слияние свободного (ещё не лежащего в корзине) блока со свободными соседями по памяти
+BlockInfo* ListMemoryResource::coalesce(BlockInfo* block) noexcept {
+    auto next = std::next(block->self);
+    if (next != blocks.end() && next->chunk == block->chunk && !next->is_allocated) {
+        unlink_free(&*next);
+        block->size += next->size;
+        block->ever_used |= next->ever_used;
+        blocks.erase(next);
+    }
+
+    if (block->self != blocks.begin()) {
+        auto prev = std::prev(block->self);
+        if (prev->chunk == block->chunk && !prev->is_allocated) {
+            unlink_free(&*prev);
+            prev->size += block->size;
+            prev->ever_used |= block->ever_used;
+            blocks.erase(block->self);
+            block = &*prev;
+        }
+    }
+    return block;
+}
+
+void* ListMemoryResource::do_allocate(size_t bytes, size_t alignment) {
+    size_t size = round_up(std::max<size_t>(bytes, 1), kGranularity);
+    if (size > SIZE_MAX - alignment) {
+        throw std::bad_alloc(); // размер вместе с отступом для выравнивания не помещается в size_t
+    }
+
+    // === 2. Повторное переиспользование ранее освобождённой памяти ===
+    BlockInfo* block = find_fit(size, alignment);
+    if (!block) {
+        block = add_chunk(size, alignment);
+    }
+    unlink_free(block);
+
+    try {
+        // Начало блока выравниваем, отрезая спереди свободный блок
+        if (size_t pad = padding_for(*block, alignment)) {
+            BlockInfo* aligned = split(block, pad);
+            push_free(block);
+            block = aligned;
+        }
+        // Лишний хвост возвращаем в свободные
+        if (block->size - size >= kMinSplit) {
+            push_free(split(block, size));
+        }
+        index.emplace(block->ptr, block);
+    } catch (...) {
+        push_free(block);
+        throw;
+    }
+
+    block->is_allocated = true;
+    ++chunks[block->chunk].allocated_blocks;
+    block->alignment = alignment;
+    bool reused = block->ever_used;
+    block->ever_used = true;
+
+    MY_VECTOR_TRACE(trace, reused ? TraceOp::Reuse : TraceOp::Allocate, block->ptr, bytes, alignment);
+    (void)reused;
+    return block->ptr;
+}
+
+// Освобождение памяти
+void ListMemoryResource::do_deallocate(void* ptr, [[maybe_unused]] size_t bytes, [[maybe_unused]] size_t alignment) {
+    auto it = index.find(ptr);
+    if (it == index.end() || !it->second->is_allocated) {
         throw std::runtime_error("Trying to deallocate non-allocated pointer");
     }
+
+    BlockInfo* block = it->second;
+    index.erase(it);
+    block->is_allocated = false;
+    --chunks[block->chunk].allocated_blocks;
+    MY_VECTOR_TRACE(trace, TraceOp::Deallocate, ptr, bytes, alignment);
+
+    chunks[block->chunk].last_free = ++free_tick;
+    push_free(coalesce(block));
+
+    if (free_total > retention_limit) {
+        trim(retention_limit);
+    }
+}
+
+size_t ListMemoryResource::largest_free_block() const noexcept {
+    if (!nonempty_bins) {
+        return 0;
+    }
+    size_t bin = static_cast<size_t>(std::bit_width(nonempty_bins)) - 1;
+    size_t largest = 0;
+    for (const BlockInfo* block = free_bins[bin]; block; block = block->next_free) {
+        largest = std::max(largest, block->size);
+    }
+    return largest;
+}
+
+double ListMemoryResource::fragmentation() const noexcept {
+    if (free_total == 0) {
+        return 0.0;
+    }
+    return 1.0 - static_cast<double>(largest_free_block()) / static_cast<double>(free_total);
 }
 
 // Сравнение memory_resource
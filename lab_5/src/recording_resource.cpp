@@ -0,0 +1,258 @@
+#include "../include/recording_resource.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace my_vector {
+
+namespace {
+
+constexpr uint32_t kTraceMagic = 0x5441564D; // "MVAT"
+constexpr uint32_t kTraceVersion = 1;
+
+struct TraceHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t record_count;
+    uint64_t allocation_count;
+};
+
+void write_varint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+uint64_t read_varint(std::istream& is) {
+    uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        int byte = is.get();
+        if (byte == std::char_traits<char>::eof()) {
+            throw std::runtime_error("allocation trace is truncated");
+        }
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return value;
+        }
+    }
+    throw std::runtime_error("allocation trace is corrupted");
+}
+
+// Число записей из заголовка не проверено: заранее резервируем не больше, чем может
+// поместиться в оставшихся байтах потока (запись - минимум байт), иначе - не больше буфера
+uint64_t reserve_hint(std::istream& is, uint64_t count) {
+    uint64_t limit = 64 * 1024;
+    std::istream::pos_type here = is.tellg();
+    if (here != std::istream::pos_type(-1)) {
+        is.seekg(0, std::ios::end);
+        std::istream::pos_type end = is.tellg();
+        is.seekg(here);
+        if (end != std::istream::pos_type(-1) && end >= here) {
+            limit = static_cast<uint64_t>(end - here);
+        }
+    }
+    return std::min(count, limit);
+}
+
+} // namespace
+
+// === AllocationTrace ===
+void AllocationTrace::write(std::ostream& os) const {
+    TraceHeader header{kTraceMagic, kTraceVersion, records.size(), allocation_count};
+    os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    std::string buffer;
+    buffer.reserve(64 * 1024);
+    for (const AllocRecord& record : records) {
+        if (record.kind == AllocRecord::Kind::Allocate) {
+            write_varint(buffer, record.size_or_id << 1);
+            buffer.push_back(static_cast<char>(std::countr_zero(record.alignment)));
+        } else {
+            write_varint(buffer, (record.size_or_id << 1) | 1);
+        }
+        if (buffer.size() >= 60 * 1024) {
+            os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+    }
+    os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    if (!os) {
+        throw std::runtime_error("allocation trace write failed");
+    }
+}
+
+void AllocationTrace::write(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        throw std::runtime_error("cannot open trace file " + path);
+    }
+    write(out);
+}
+
+AllocationTrace AllocationTrace::read(std::istream& is) {
+    TraceHeader header{};
+    if (!is.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.magic != kTraceMagic) {
+        throw std::runtime_error("not an allocation trace");
+    }
+    if (header.version != kTraceVersion) {
+        throw std::runtime_error("unsupported allocation trace version");
+    }
+
+    AllocationTrace trace;
+    trace.allocation_count = header.allocation_count;
+    trace.records.reserve(reserve_hint(is, header.record_count));
+    uint64_t allocations = 0;
+    for (uint64_t i = 0; i < header.record_count; ++i) {
+        uint64_t value = read_varint(is);
+        if (value & 1) {
+            uint64_t id = value >> 1;
+            if (id >= allocations) {
+                throw std::runtime_error("allocation trace refers to an unknown allocation");
+            }
+            trace.records.push_back({AllocRecord::Kind::Deallocate, id, 0});
+        } else {
+            int shift = is.get();
+            if (shift == std::char_traits<char>::eof() || shift >= 32) {
+                throw std::runtime_error("allocation trace is corrupted");
+            }
+            trace.records.push_back({AllocRecord::Kind::Allocate, value >> 1, uint32_t{1} << shift});
+            ++allocations;
+        }
+    }
+    if (allocations != header.allocation_count) {
+        throw std::runtime_error("allocation trace is corrupted");
+    }
+    return trace;
+}
+
+AllocationTrace AllocationTrace::read(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("cannot open trace file " + path);
+    }
+    return read(in);
+}
+
+// === RecordingResource ===
+RecordingResource::RecordingResource(std::pmr::memory_resource* upstream) : upstream(upstream) {
+    if (!upstream) {
+        throw std::invalid_argument("RecordingResource: upstream resource is null");
+    }
+}
+
+void* RecordingResource::do_allocate(size_t bytes, size_t alignment) {
+    void* p = upstream->allocate(bytes, alignment);
+    try {
+        std::lock_guard<std::mutex> lock(mutex);
+        recorded.records.push_back({AllocRecord::Kind::Allocate, bytes, static_cast<uint32_t>(alignment)});
+        try {
+            live[p] = recorded.allocation_count;
+        } catch (...) {
+            recorded.records.pop_back();
+            throw;
+        }
+        ++recorded.allocation_count;
+    } catch (...) {
+        // запись не удалась - блок возвращаем, а не теряем
+        upstream->deallocate(p, bytes, alignment);
+        throw;
+    }
+    return p;
+}
+
+void RecordingResource::do_deallocate(void* p, size_t bytes, size_t alignment) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = live.find(p);
+        if (it == live.end()) {
+            throw std::runtime_error("RecordingResource: pointer was not allocated by this resource");
+        }
+        recorded.records.push_back({AllocRecord::Kind::Deallocate, it->second, 0});
+        live.erase(it);
+    }
+    upstream->deallocate(p, bytes, alignment);
+}
+
+bool RecordingResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+AllocationTrace RecordingResource::trace() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return recorded;
+}
+
+void RecordingResource::save(const std::string& path) const {
+    trace().write(path);
+}
+
+// === Воспроизведение ===
+ReplayResult replay(const AllocationTrace& trace, std::pmr::memory_resource* resource) {
+    struct Block {
+        void* ptr = nullptr;
+        uint64_t size = 0;
+        uint32_t alignment = 0;
+    };
+    // вся служебная память выделяется до замера
+    std::vector<Block> blocks(trace.allocation_count);
+    std::vector<void*> given(trace.allocation_count, nullptr);
+    std::vector<void*> released;
+    released.reserve(trace.allocation_count);
+
+    ReplayResult result;
+    uint64_t next_id = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const AllocRecord& record : trace.records) {
+        if (record.kind == AllocRecord::Kind::Allocate) {
+            Block& block = blocks[next_id];
+            block = {resource->allocate(record.size_or_id, record.alignment), record.size_or_id, record.alignment};
+            given[next_id] = block.ptr;
+            ++next_id;
+            result.bytes_allocated += record.size_or_id;
+        } else {
+            Block& block = blocks[record.size_or_id];
+            if (!block.ptr) {
+                throw std::runtime_error("allocation trace frees the same allocation twice");
+            }
+            resource->deallocate(block.ptr, block.size, block.alignment);
+            released.push_back(block.ptr);
+            block.ptr = nullptr;
+        }
+    }
+    auto finish = std::chrono::steady_clock::now();
+    result.operations = trace.records.size();
+    result.seconds = std::chrono::duration<double>(finish - start).count();
+
+    // Повторное использование считаем после замера: адрес выделения встречался среди
+    // освобождённых раньше него (порядок освобождений восстанавливаем по трассе)
+    std::unordered_set<void*> freed;
+    uint64_t hits = 0;
+    next_id = 0;
+    size_t released_pos = 0;
+    for (const AllocRecord& record : trace.records) {
+        if (record.kind == AllocRecord::Kind::Allocate) {
+            if (freed.erase(given[next_id])) {
+                ++hits;
+            }
+            ++next_id;
+        } else {
+            freed.insert(released[released_pos++]);
+        }
+    }
+    result.reuse_rate = trace.allocation_count ? static_cast<double>(hits) / static_cast<double>(trace.allocation_count) : 0.0;
+
+    for (Block& block : blocks) {
+        if (block.ptr) {
+            resource->deallocate(block.ptr, block.size, block.alignment);
+            ++result.leaked;
+        }
+    }
+    return result;
+}
+
+} // namespace my_vector
@@ -0,0 +1,257 @@
+#include "../include/stats_resource.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <fstream>
+#include <new>
+#include <stdexcept>
+#include <thread>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <x86intrin.h>
+#define MY_VECTOR_HAS_RDTSC 1
+#endif
+
+namespace my_vector {
+
+namespace {
+
+uint64_t steady_ns() noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+size_t latency_bucket(uint64_t value) noexcept {
+    constexpr size_t sub = LatencyHistogram::kSubBuckets;
+    if (value < sub) {
+        return static_cast<size_t>(value);
+    }
+    // старший бит задаёт степень двойки, следующие 4 бита - корзину внутри неё
+    size_t exponent = static_cast<size_t>(std::bit_width(value)) - 1;
+    size_t mantissa = static_cast<size_t>(value >> (exponent - 4)) & (sub - 1);
+    return (exponent - 3) * sub + mantissa;
+}
+
+uint64_t bucket_upper_bound(size_t bucket) noexcept {
+    constexpr size_t sub = LatencyHistogram::kSubBuckets;
+    if (bucket < sub) {
+        return bucket;
+    }
+    size_t exponent = bucket / sub + 3;
+    uint64_t mantissa = bucket % sub;
+    uint64_t lower = (uint64_t{1} << exponent) | (mantissa << (exponent - 4));
+    return lower + (uint64_t{1} << (exponent - 4)) - 1;
+}
+
+size_t size_class(size_t bytes) noexcept {
+    return bytes <= 1 ? 0 : std::min<size_t>(std::bit_width(bytes - 1), AllocStats::kSizeClasses - 1);
+}
+
+size_t lifetime_bucket(uint64_t ns) noexcept {
+    return ns == 0 ? 0 : static_cast<size_t>(std::bit_width(ns)) - 1;
+}
+
+void write_array(std::ostream& os, const char* name, const uint64_t* values, size_t count) {
+    // хвост из нулей не пишем
+    while (count > 0 && values[count - 1] == 0) {
+        --count;
+    }
+    os << "  \"" << name << "\": [";
+    for (size_t i = 0; i < count; ++i) {
+        os << (i ? ", " : "") << values[i];
+    }
+    os << "]";
+}
+
+} // namespace
+
+// === LatencyHistogram ===
+void LatencyHistogram::record(uint64_t value) noexcept {
+    ++buckets[latency_bucket(value)];
+    ++total;
+    max_value = std::max(max_value, value);
+}
+
+uint64_t LatencyHistogram::percentile(double q) const noexcept {
+    if (total == 0) {
+        return 0;
+    }
+    uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(total - 1)) + 1;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBuckets; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return std::min(bucket_upper_bound(i), max_value);
+        }
+    }
+    return max_value;
+}
+
+void LatencyHistogram::reset() noexcept {
+    buckets.fill(0);
+    total = 0;
+    max_value = 0;
+}
+
+// === LowOverheadClock ===
+uint64_t LowOverheadClock::now() noexcept {
+#ifdef MY_VECTOR_HAS_RDTSC
+    return __rdtsc();
+#else
+    return steady_ns();
+#endif
+}
+
+double LowOverheadClock::ticks_per_ns() {
+#ifdef MY_VECTOR_HAS_RDTSC
+    static const double ratio = [] {
+        uint64_t ns_start = steady_ns();
+        uint64_t ticks_start = __rdtsc();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        uint64_t ticks = __rdtsc() - ticks_start;
+        uint64_t ns = steady_ns() - ns_start;
+        return ns ? static_cast<double>(ticks) / static_cast<double>(ns) : 1.0;
+    }();
+    return ratio;
+#else
+    return 1.0;
+#endif
+}
+
+// === AllocStats ===
+void AllocStats::dump_json(std::ostream& os) const {
+    os << "{\n"
+       << "  \"allocations\": " << allocations << ",\n"
+       << "  \"deallocations\": " << deallocations << ",\n"
+       << "  \"reuse_hits\": " << reuse_hits << ",\n"
+       << "  \"reuse_rate\": " << reuse_rate() << ",\n"
+       << "  \"bytes_live\": " << bytes_live << ",\n"
+       << "  \"bytes_freed\": " << bytes_freed << ",\n"
+       << "  \"bytes_peak\": " << bytes_peak << ",\n"
+       << "  \"bytes_allocated\": " << bytes_allocated << ",\n";
+    write_array(os, "size_classes_log2", size_classes.data(), size_classes.size());
+    os << ",\n";
+    write_array(os, "lifetime_ns_log2", lifetime_ns.data(), lifetime_ns.size());
+    os << ",\n"
+       << "  \"allocate_latency_ns\": {\"p50\": " << allocate_p50_ns << ", \"p99\": " << allocate_p99_ns
+       << ", \"p999\": " << allocate_p999_ns << "},\n"
+       << "  \"deallocate_latency_ns\": {\"p50\": " << deallocate_p50_ns << ", \"p99\": " << deallocate_p99_ns
+       << ", \"p999\": " << deallocate_p999_ns << "}\n"
+       << "}\n";
+}
+
+// === StatsResource ===
+// Калибровка часов выполняется здесь, а не при первом deallocate под мьютексом
+StatsResource::StatsResource(std::pmr::memory_resource* upstream)
+    : upstream(upstream), ticks_per_ns(LowOverheadClock::ticks_per_ns()) {
+    if (!upstream) {
+        throw std::invalid_argument("StatsResource: upstream resource is null");
+    }
+}
+
+void* StatsResource::do_allocate(size_t bytes, size_t alignment) {
+    uint64_t start = LowOverheadClock::now();
+    void* p = upstream->allocate(bytes, alignment);
+    uint64_t finish = LowOverheadClock::now();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    try {
+        live[p] = finish;
+    } catch (...) {
+        // учёт не удался - блок не должен потеряться
+        lock.unlock();
+        upstream->deallocate(p, bytes, alignment);
+        throw;
+    }
+    allocate_latency.record(finish - start);
+    ++counters.allocations;
+    ++counters.size_classes[size_class(bytes)];
+    counters.bytes_allocated += bytes;
+    counters.bytes_live += bytes;
+    counters.bytes_peak = std::max(counters.bytes_peak, counters.bytes_live);
+    if (released.erase(p)) {
+        ++counters.reuse_hits;
+    }
+    return p;
+}
+
+// Учёт делается до возврата блока upstream: иначе другой поток может получить тот же
+// адрес и поставить его на учёт раньше, чем этот поток его снимет
+void StatsResource::do_deallocate(void* p, size_t bytes, size_t alignment) {
+    uint64_t start = LowOverheadClock::now();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++counters.deallocations;
+        counters.bytes_freed += bytes;
+        counters.bytes_live -= std::min<uint64_t>(bytes, counters.bytes_live);
+        if (auto it = live.find(p); it != live.end()) {
+            // время жизни переводим в наносекунды сразу: корзины - степени двойки
+            uint64_t ticks = start - it->second;
+            ++counters.lifetime_ns[lifetime_bucket(static_cast<uint64_t>(static_cast<double>(ticks) / ticks_per_ns))];
+            live.erase(it);
+        }
+        remember_released(p);
+    }
+
+    uint64_t upstream_start = LowOverheadClock::now();
+    upstream->deallocate(p, bytes, alignment);
+    uint64_t finish = LowOverheadClock::now();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    deallocate_latency.record(finish - upstream_start);
+}
+
+// Множество освобождённых адресов ограничено kMaxReleased: при переполнении вытесняется
+// произвольный адрес, и его повторная выдача не попадёт в reuse_hits
+void StatsResource::remember_released(void* p) noexcept {
+    try {
+        if (released.size() >= kMaxReleased) {
+            released.erase(released.begin());
+        }
+        released.insert(p);
+    } catch (const std::bad_alloc&) {
+        // без памяти под учёт повторное использование этого адреса просто не посчитается
+    }
+}
+
+bool StatsResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+AllocStats StatsResource::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    AllocStats result = counters;
+    auto to_ns = [this](uint64_t ticks) { return static_cast<double>(ticks) / ticks_per_ns; };
+    result.allocate_p50_ns = to_ns(allocate_latency.percentile(0.5));
+    result.allocate_p99_ns = to_ns(allocate_latency.percentile(0.99));
+    result.allocate_p999_ns = to_ns(allocate_latency.percentile(0.999));
+    result.deallocate_p50_ns = to_ns(deallocate_latency.percentile(0.5));
+    result.deallocate_p99_ns = to_ns(deallocate_latency.percentile(0.99));
+    result.deallocate_p999_ns = to_ns(deallocate_latency.percentile(0.999));
+    return result;
+}
+
+void StatsResource::reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    uint64_t live_bytes = counters.bytes_live;
+    counters = AllocStats{};
+    counters.bytes_live = live_bytes;
+    counters.bytes_peak = live_bytes;
+    allocate_latency.reset();
+    deallocate_latency.reset();
+    released.clear();
+}
+
+void StatsResource::dump_json(std::ostream& os) const {
+    stats().dump_json(os);
+}
+
+void StatsResource::dump_json(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        throw std::runtime_error("cannot open stats file " + path);
+    }
+    dump_json(out);
+}
+
+} // namespace my_vector
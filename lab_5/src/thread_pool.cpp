@@ -0,0 +1,124 @@
+#include "../include/thread_pool.h"
+#include "../include/my_memory_resource.h"
+
+namespace my_vector::parallel {
+
+namespace {
+
+// Очередь, принадлежащая текущему потоку (если он рабочий поток какого-то пула)
+struct WorkerIdentity {
+    const ThreadPool* pool = nullptr;
+    size_t index = 0;
+};
+thread_local WorkerIdentity current_worker;
+
+} // namespace
+
+ThreadPool::ThreadPool(size_t threads) {
+    queues.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+    workers.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        workers.emplace_back([this, i] { worker_loop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::spawn(Task task) {
+    if (queues.empty()) {
+        task(); // пул без рабочих потоков - выполняем сразу
+        return;
+    }
+    size_t index = (current_worker.pool == this) ? current_worker.index
+                                                  : next_queue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+    queued.fetch_add(1, std::memory_order_release);
+    // захват мьютекса упорядочивает пробуждение с проверкой в worker_loop
+    { std::lock_guard<std::mutex> lock(sleep_mutex); }
+    wake.notify_one();
+}
+
+bool ThreadPool::try_pop_local(size_t index, Task& task) {
+    WorkQueue& queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    queued.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool ThreadPool::try_steal(size_t thief, Task& task) {
+    size_t count = queues.size();
+    for (size_t shift = 1; shift <= count; ++shift) {
+        WorkQueue& queue = *queues[(thief + shift) % count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::try_take(Task& task) {
+    if (current_worker.pool == this) {
+        return try_pop_local(current_worker.index, task) || try_steal(current_worker.index, task);
+    }
+    return try_steal(next_queue.load(std::memory_order_relaxed), task);
+}
+
+void ThreadPool::help_while(const std::function<bool()>& pending) {
+    Task task;
+    while (pending()) {
+        if (try_take(task)) {
+            task();
+            task = nullptr;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void ThreadPool::worker_loop(size_t index) {
+    current_worker = {this, index};
+    Task task;
+    while (true) {
+        if (try_pop_local(index, task) || try_steal(index, task)) {
+            task();
+            task = nullptr;
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+        wake.wait(lock, [this] { return stopping || queued.load(std::memory_order_acquire) > 0; });
+        if (stopping) {
+            return;
+        }
+    }
+}
+
+std::pmr::memory_resource* scratch_resource() {
+    thread_local ListMemoryResource resource;
+    return &resource;
+}
+
+} // namespace my_vector::parallel
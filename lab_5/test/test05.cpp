@@ -1,7 +1,31 @@
 #include "../include/vector.h"
 #include "../include/vector_iterator.h"
+#include "../include/dense_vector.h"
+#include "../include/concurrent_memory_resource.h"
+#include "../include/vector_io.h"
+#include "../include/soa_vector.h"
+#include "../include/stats_resource.h"
+#include "../include/concurrent_vector.h"
+#include "../include/parallel.h"
+#include "../include/recording_resource.h"
+#include "../include/ingest.h"
 #include <gtest/gtest.h>
 #include <string>
+#include <sstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <random>
+#include <algorithm>
+#include <ranges>
+#include <list>
+#include <numeric>
+#include <filesystem>
+#include <set>
+#include <memory>
+#include <fstream>
+#include <cstring>
 
 class PmrVectorTest : public ::testing::Test {
 protected:
@@ -165,3 +189,2379 @@ TEST_F(PmrVectorTest, ReuseDeallocatedMemory) {
     // Проверяем, что память первого удалённого элемента могла быть переиспользована
     EXPECT_TRUE(ptr1 == &(*vec)[1] || ptr2 == &(*vec)[0]);
 }
+
+// === 13. Блок переиспользуется для запроса того же size-класса ===
+TEST(ListMemoryResourceTest, SizeClassReuse) {
+    my_vector::ListMemoryResource resource;
+
+    void* a = resource.allocate(20, alignof(int));
+    void* b = resource.allocate(100, alignof(int));
+    resource.deallocate(a, 20, alignof(int));
+
+    // 24 байта попадают в тот же класс (32 байта), что и 20
+    void* c = resource.allocate(24, alignof(int));
+    EXPECT_EQ(a, c);
+
+    resource.deallocate(b, 100, alignof(int));
+    resource.deallocate(c, 24, alignof(int));
+}
+
+// === 14. Освобождение чужого указателя и повторное освобождение ===
+TEST(ListMemoryResourceTest, DeallocateUnknownPointerThrows) {
+    my_vector::ListMemoryResource resource;
+    int local = 0;
+
+    EXPECT_THROW(resource.deallocate(&local, sizeof(int), alignof(int)), std::runtime_error);
+
+    void* p = resource.allocate(sizeof(int), alignof(int));
+    resource.deallocate(p, sizeof(int), alignof(int));
+    EXPECT_THROW(resource.deallocate(p, sizeof(int), alignof(int)), std::runtime_error);
+}
+
+// === 15. Большое число элементов (раньше - квадратичное время) ===
+TEST(ListMemoryResourceTest, ManyElements) {
+    my_vector::ListMemoryResource resource;
+    my_vector::PmrVector<int> vec(&resource);
+
+    for (int i = 0; i < 20000; ++i) {
+        vec.push_back(i);
+    }
+    for (int i = 0; i < 10000; ++i) {
+        vec.pop_back();
+    }
+    for (int i = 0; i < 10000; ++i) {
+        vec.push_back(i);
+    }
+    EXPECT_EQ(vec.size(), 20000);
+    EXPECT_EQ(vec.back(), 9999);
+}
+
+// === 16. Кольцевой буфер трассировки: порядок событий и переполнение ===
+TEST(AllocTraceTest, RecordDrainAndOverflow) {
+    my_vector::AllocTrace trace(4);
+    int dummy = 0;
+
+    trace.record(my_vector::TraceOp::Allocate, &dummy, 4, 4);
+    trace.record(my_vector::TraceOp::Deallocate, &dummy, 4, 4);
+
+    std::vector<my_vector::TraceEvent> events;
+    EXPECT_EQ(trace.drain(events), 2);
+    EXPECT_EQ(events[0].op, my_vector::TraceOp::Allocate);
+    EXPECT_EQ(events[1].op, my_vector::TraceOp::Deallocate);
+    EXPECT_LE(events[0].timestamp_ns, events[1].timestamp_ns);
+
+    for (int i = 0; i < 6; ++i) {
+        trace.record(my_vector::TraceOp::Reuse, &dummy, i, 4);
+    }
+    events.clear();
+    EXPECT_EQ(trace.drain(events), 4);
+    EXPECT_EQ(trace.dropped(), 2);
+    EXPECT_EQ(events.front().size, 2);
+
+    trace.record(my_vector::TraceOp::Cleanup, &dummy, 4, 4);
+    std::ostringstream json;
+    trace.dump_chrome_json(json);
+    EXPECT_NE(json.str().find("\"traceEvents\""), std::string::npos);
+    EXPECT_NE(json.str().find("\"cleanup\""), std::string::npos);
+}
+
+#ifdef MY_VECTOR_ALLOC_TRACE
+// === 17. События ListMemoryResource попадают в буфер ===
+TEST(AllocTraceTest, ResourceEmitsEvents) {
+    my_vector::AllocTrace trace;
+    my_vector::ListMemoryResource resource;
+    resource.set_trace(&trace);
+
+    void* p = resource.allocate(sizeof(int), alignof(int));
+    resource.deallocate(p, sizeof(int), alignof(int));
+    void* q = resource.allocate(sizeof(int), alignof(int));
+    resource.deallocate(q, sizeof(int), alignof(int));
+
+    std::vector<my_vector::TraceEvent> events;
+    ASSERT_EQ(trace.drain(events), 4);
+    EXPECT_EQ(events[0].op, my_vector::TraceOp::Allocate);
+    EXPECT_EQ(events[2].op, my_vector::TraceOp::Reuse);
+    resource.set_trace(nullptr);
+}
+#endif
+
+// === 18. PmrDenseVector хранит элементы подряд в одном буфере ===
+TEST(PmrDenseVectorTest, ContiguousStorage) {
+    my_vector::ListMemoryResource resource;
+    my_vector::PmrDenseVector<int> vec(&resource);
+
+    for (int i = 0; i < 100; ++i) {
+        vec.push_back(i);
+    }
+    ASSERT_EQ(vec.size(), 100);
+    for (size_t i = 0; i < vec.size(); ++i) {
+        EXPECT_EQ(&vec[i], vec.data() + i);
+        EXPECT_EQ(vec[i], static_cast<int>(i));
+    }
+    EXPECT_THROW(vec.at(100), std::out_of_range);
+}
+
+// === 19. insert/erase/pop_back у PmrDenseVector со сложным типом ===
+TEST(PmrDenseVectorTest, InsertEraseStrings) {
+    my_vector::ListMemoryResource resource;
+    my_vector::PmrDenseVector<std::string> vec(&resource);
+
+    vec.push_back("Valentin");
+    vec.push_back("Donald");
+    vec.insert(1, "Vladimir");
+    vec.insert(0, "Bjarne");
+    vec.insert(4, "Alexander");
+
+    std::string concat;
+    for (const auto& s : vec) {
+        concat += s + " ";
+    }
+    EXPECT_EQ(concat, "Bjarne Valentin Vladimir Donald Alexander ");
+
+    vec.erase(0);
+    vec.pop_back();
+    EXPECT_EQ(vec.front(), "Valentin");
+    EXPECT_EQ(vec.back(), "Donald");
+    EXPECT_EQ(vec.size(), 3);
+
+    vec.push_back(vec[0]);
+    EXPECT_EQ(vec.back(), "Valentin");
+
+    EXPECT_THROW(vec.insert(10, "x"), std::out_of_range);
+    EXPECT_THROW(vec.erase(10), std::out_of_range);
+    vec.clear();
+    EXPECT_TRUE(vec.empty());
+    EXPECT_THROW(vec.pop_back(), std::runtime_error);
+}
+
+// Считает обращения к memory_resource, сама память берётся у new_delete_resource
+class CountingResource : public std::pmr::memory_resource {
+public:
+    size_t allocations = 0;
+    size_t deallocations = 0;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        ++deallocations;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+// === 20. Элементы выделяются кусками, адреса стабильны при росте ===
+TEST(PmrVectorSlabTest, BulkAllocationKeepsAddressesStable) {
+    CountingResource resource;
+    {
+        my_vector::PmrVector<int> vec(&resource);
+        vec.push_back(0);
+        int* first = &vec[0];
+
+        for (int i = 1; i < 10000; ++i) {
+            vec.push_back(i);
+        }
+        EXPECT_EQ(first, &vec[0]);
+        EXPECT_EQ(vec[9999], 9999);
+        // 10000 элементов + таблица указателей: на порядки меньше 10000 вызовов
+        EXPECT_LT(resource.allocations, 100);
+    }
+    EXPECT_EQ(resource.allocations, resource.deallocations);
+}
+
+// === 21. Слоты после pop_back/erase переиспользуются без обращения к ресурсу ===
+TEST(PmrVectorSlabTest, FreedSlotsAreRecycled) {
+    CountingResource resource;
+    my_vector::PmrVector<std::string> vec(&resource);
+    vec.reserve(16);
+    for (int i = 0; i < 16; ++i) {
+        vec.push_back("value");
+    }
+    size_t allocations = resource.allocations;
+
+    std::string* erased = &vec[3];
+    vec.erase(3);
+    vec.pop_back();
+    vec.push_back("again");
+    vec.insert(0, "first");
+
+    EXPECT_EQ(resource.allocations, allocations);
+    EXPECT_TRUE(&vec[0] == erased || &vec.back() == erased);
+}
+
+// === 22. Многопоточный стресс-тест: один блок не выдаётся дважды ===
+TEST(ConcurrentListMemoryResourceTest, NoBlockHandedOutTwice) {
+    my_vector::ConcurrentListMemoryResource resource;
+    constexpr int kThreads = 8;
+    constexpr int kIterations = 20000;
+    constexpr size_t kSizes[] = {8, 24, 64, 200, 1000};
+
+    struct Live {
+        uint64_t* ptr;
+        size_t bytes;
+        uint64_t stamp;
+    };
+
+    // Через exchange блоки освобождаются в чужом потоке
+    std::mutex exchange_mutex;
+    std::vector<Live> exchange;
+    std::atomic<bool> corrupted{false};
+
+    auto check_and_free = [&](const Live& block) {
+        for (size_t i = 0; i < block.bytes / sizeof(uint64_t); ++i) {
+            if (block.ptr[i] != block.stamp) {
+                corrupted = true;
+            }
+        }
+        resource.deallocate(block.ptr, block.bytes, alignof(uint64_t));
+    };
+
+    auto worker = [&](int thread_index) {
+        std::mt19937 rng(thread_index);
+        std::vector<Live> live;
+        for (int i = 0; i < kIterations; ++i) {
+            size_t bytes = kSizes[rng() % std::size(kSizes)];
+            uint64_t stamp = (uint64_t(thread_index) << 32) | uint64_t(i);
+            auto* ptr = static_cast<uint64_t*>(resource.allocate(bytes, alignof(uint64_t)));
+            std::fill(ptr, ptr + bytes / sizeof(uint64_t), stamp);
+            live.push_back({ptr, bytes, stamp});
+
+            if (live.size() > 64) {
+                Live block = live[rng() % live.size()];
+                live.erase(std::find_if(live.begin(), live.end(), [&](const Live& l) { return l.ptr == block.ptr; }));
+                if (rng() % 2) {
+                    check_and_free(block);
+                } else {
+                    std::lock_guard<std::mutex> lock(exchange_mutex);
+                    exchange.push_back(block);
+                }
+            }
+
+            std::vector<Live> foreign;
+            if (i % 16 == 0) {
+                std::lock_guard<std::mutex> lock(exchange_mutex);
+                foreign.swap(exchange);
+            }
+            for (const Live& block : foreign) {
+                check_and_free(block);
+            }
+        }
+        for (const Live& block : live) {
+            check_and_free(block);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back(worker, t);
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    for (const Live& block : exchange) {
+        check_and_free(block);
+    }
+    EXPECT_FALSE(corrupted);
+}
+
+// === 23. Общий ресурс для нескольких PmrVector в разных потоках ===
+TEST(ConcurrentListMemoryResourceTest, SharedBetweenVectors) {
+    my_vector::ConcurrentListMemoryResource resource;
+    constexpr int kThreads = 4;
+    std::vector<size_t> sums(kThreads);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            my_vector::PmrVector<std::string> vec(&resource);
+            for (int i = 0; i < 5000; ++i) {
+                vec.push_back(std::string(40, char('a' + t)));
+            }
+            for (const auto& s : vec) {
+                sums[t] += std::count(s.begin(), s.end(), char('a' + t));
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    void* p = resource.allocate(32, 8);
+    void* q = resource.allocate(32, 8);
+    EXPECT_NE(p, q);
+    resource.deallocate(p, 32, 8);
+    resource.deallocate(q, 32, 8);
+    for (size_t sum : sums) {
+        EXPECT_EQ(sum, 5000u * 40u);
+    }
+}
+
+// === 24. Итератор произвольного доступа и стандартные алгоритмы ===
+TEST_F(PmrVectorTest, RandomAccessAlgorithms) {
+    static_assert(std::random_access_iterator<my_vector::PmrVector<int>::ConstIterator>);
+    static_assert(std::ranges::random_access_range<my_vector::PmrVector<int>>);
+
+    for (int value : {5, 3, 9, 1, 7, 2, 8}) {
+        vec->push_back(value);
+    }
+    int* addr_of_nine = &(*vec)[2];
+
+    auto it = vec->begin();
+    EXPECT_EQ(it[2], 9);
+    EXPECT_EQ(*(it + 4), 7);
+    EXPECT_EQ(vec->end() - vec->begin(), 7);
+    EXPECT_TRUE(vec->begin() < vec->end());
+
+    std::nth_element(vec->begin(), vec->begin() + 3, vec->end());
+    EXPECT_EQ((*vec)[3], 5);
+
+    std::sort(vec->begin(), vec->end());
+    EXPECT_TRUE(std::is_sorted(vec->cbegin(), vec->cend()));
+    EXPECT_EQ(*std::lower_bound(vec->begin(), vec->end(), 6), 7);
+    // std::sort переставляет значения, а не блоки - адреса элементов не меняются
+    EXPECT_EQ(addr_of_nine, &(*vec)[2]);
+}
+
+// === 25. Константные и обратные итераторы ===
+TEST_F(PmrVectorTest, ConstAndReverseIterators) {
+    vec->push_back(1);
+    vec->push_back(2);
+    vec->push_back(3);
+
+    const my_vector::PmrVector<int>& cvec = *vec;
+    my_vector::PmrVector<int>::ConstIterator cit = vec->begin();
+    EXPECT_EQ(cit, cvec.begin());
+
+    std::vector<int> reversed(cvec.rbegin(), cvec.rend());
+    EXPECT_EQ(reversed, (std::vector<int>{3, 2, 1}));
+
+    int sum = 0;
+    for (auto it = vec->crbegin(); it != vec->crend(); ++it) {
+        sum += *it;
+    }
+    EXPECT_EQ(sum, 6);
+}
+
+// Считает копирования и перемещения - проверка пути без копий
+struct CopyCounter {
+    static inline int copies = 0;
+    static inline int moves = 0;
+
+    std::string name;
+    int id = 0;
+
+    CopyCounter(std::string n, int i) : name(std::move(n)), id(i) {}
+    CopyCounter(const CopyCounter& other) : name(other.name), id(other.id) { ++copies; }
+    CopyCounter(CopyCounter&& other) noexcept : name(std::move(other.name)), id(other.id) { ++moves; }
+    CopyCounter& operator=(const CopyCounter& other) { name = other.name; id = other.id; ++copies; return *this; }
+    CopyCounter& operator=(CopyCounter&& other) noexcept { name = std::move(other.name); id = other.id; ++moves; return *this; }
+};
+
+my_vector::PmrVector<CopyCounter> make_vector(std::pmr::memory_resource* resource) {
+    my_vector::PmrVector<CopyCounter> vec(resource);
+    vec.emplace_back("Donald Knuth", 778);
+    return vec;
+}
+
+// === 26. emplace_back/emplace/push_back(T&&) не копируют элементы ===
+TEST(PmrVectorMoveTest, EmplaceWithoutCopies) {
+    my_vector::ListMemoryResource resource;
+    CopyCounter::copies = 0;
+    CopyCounter::moves = 0;
+
+    my_vector::PmrVector<CopyCounter> vec(&resource);
+    vec.emplace_back("Valentin Zaitsev", 776);
+    vec.push_back(CopyCounter("Vladimir Putin", 777));
+    CopyCounter& inserted = vec.emplace(0, "Bjarne Stroustrup", 1);
+    for (int i = 0; i < 100; ++i) {
+        vec.emplace_back("Worker", i);
+    }
+
+    EXPECT_EQ(CopyCounter::copies, 0);
+    EXPECT_EQ(CopyCounter::moves, 1);
+    EXPECT_EQ(&inserted, &vec[0]);
+    EXPECT_EQ(vec[1].name, "Valentin Zaitsev");
+    EXPECT_EQ(vec[2].name, "Vladimir Putin");
+}
+
+// === 27. Перемещение вектора забирает таблицу указателей без копирования ===
+TEST(PmrVectorMoveTest, MoveConstructAndAssign) {
+    my_vector::ListMemoryResource resource;
+    CopyCounter::copies = 0;
+    CopyCounter::moves = 0;
+
+    my_vector::PmrVector<CopyCounter> vec = make_vector(&resource);
+    ASSERT_EQ(vec.size(), 1);
+    CopyCounter* element = &vec[0];
+
+    my_vector::PmrVector<CopyCounter> other(std::move(vec));
+    EXPECT_TRUE(vec.empty());
+    EXPECT_EQ(&other[0], element);
+
+    my_vector::PmrVector<CopyCounter> assigned(&resource);
+    assigned.emplace_back("Old", 0);
+    assigned = std::move(other);
+    EXPECT_EQ(&assigned[0], element);
+    EXPECT_EQ(assigned[0].name, "Donald Knuth");
+    EXPECT_EQ(CopyCounter::copies, 0);
+    EXPECT_EQ(CopyCounter::moves, 0);
+
+    // Перемещение вектора в контейнер стандартной библиотеки
+    std::vector<my_vector::PmrVector<CopyCounter>> holder;
+    holder.push_back(std::move(assigned));
+    EXPECT_EQ(&holder[0][0], element);
+}
+
+// === 28. Перемещение между разными ресурсами - поэлементно ===
+TEST(PmrVectorMoveTest, MoveAcrossResources) {
+    my_vector::ListMemoryResource first;
+    my_vector::ListMemoryResource second;
+    CopyCounter::copies = 0;
+    CopyCounter::moves = 0;
+
+    my_vector::PmrVector<CopyCounter> source(&first);
+    source.emplace_back("A", 1);
+    source.emplace_back("B", 2);
+
+    my_vector::PmrVector<CopyCounter> target(std::move(source), &second);
+    EXPECT_EQ(target.get_resource(), &second);
+    EXPECT_EQ(target.size(), 2);
+    EXPECT_EQ(target[1].name, "B");
+    EXPECT_EQ(CopyCounter::copies, 0);
+    EXPECT_EQ(CopyCounter::moves, 2);
+
+    my_vector::PmrVector<CopyCounter> back(&first);
+    back = std::move(target);
+    EXPECT_EQ(back.get_resource(), &first);
+    EXPECT_EQ(back[0].name, "A");
+    EXPECT_EQ(CopyCounter::copies, 0);
+}
+
+// === 29. Вставка и добавление диапазонов ===
+TEST_F(PmrVectorTest, RangeInsertAndAppend) {
+    vec->push_back(1);
+    vec->push_back(5);
+
+    std::vector<int> middle{2, 3, 4};
+    vec->insert(1, middle.begin(), middle.end());
+
+    std::list<int> tail{6, 7};
+    vec->append_range(tail);
+    vec->append_range(std::views::iota(8, 11));
+
+    std::istringstream input("-1 0");
+    vec->insert(0, std::istream_iterator<int>(input), std::istream_iterator<int>());
+
+    std::vector<int> expected(12);
+    std::iota(expected.begin(), expected.end(), -1);
+    EXPECT_EQ(std::vector<int>(vec->begin(), vec->end()), expected);
+    EXPECT_THROW(vec->insert(100, middle.begin(), middle.end()), std::out_of_range);
+}
+
+// === 30. Удаление диапазона и erase_if за один проход ===
+TEST_F(PmrVectorTest, RangeEraseAndEraseIf) {
+    for (int i = 0; i < 10; ++i) {
+        vec->push_back(i);
+    }
+    int* eight = &(*vec)[8];
+
+    vec->erase(2, 5);
+    EXPECT_EQ(std::vector<int>(vec->begin(), vec->end()), (std::vector<int>{0, 1, 5, 6, 7, 8, 9}));
+
+    EXPECT_EQ(vec->erase_if([](int x) { return x % 2 == 1; }), 4);
+    EXPECT_EQ(std::vector<int>(vec->begin(), vec->end()), (std::vector<int>{0, 6, 8}));
+
+    EXPECT_EQ(&(*vec)[2], eight);
+    EXPECT_THROW(vec->erase(3, 2), std::out_of_range);
+    EXPECT_THROW(vec->erase(0, 10), std::out_of_range);
+}
+
+// === 31. resize и assign ===
+TEST(PmrVectorRangeTest, ResizeAndAssign) {
+    CountingResource resource;
+    my_vector::PmrVector<std::string> vec(&resource);
+
+    vec.resize(3);
+    EXPECT_EQ(vec.size(), 3);
+    EXPECT_EQ(vec[2], "");
+
+    vec.resize(1000, "x");
+    EXPECT_EQ(vec.size(), 1000);
+    EXPECT_EQ(vec.back(), "x");
+    EXPECT_GE(vec.capacity(), 1000);
+
+    vec.resize(2);
+    EXPECT_EQ(vec.size(), 2);
+
+    size_t allocations = resource.allocations;
+    vec.assign(5, "Donald");
+    EXPECT_EQ(vec.size(), 5);
+    EXPECT_EQ(vec.front(), "Donald");
+    // ёмкость и слоты уже есть - повторного обращения к ресурсу нет
+    EXPECT_EQ(resource.allocations, allocations);
+
+    std::vector<std::string> names{"Valentin", "Vladimir"};
+    vec.assign(names.begin(), names.end());
+    EXPECT_EQ(vec.size(), 2);
+    EXPECT_EQ(vec.back(), "Vladimir");
+}
+
+// === 32. Расщепление: маленький запрос не занимает большой свободный блок целиком ===
+TEST(ListMemoryResourceTest, SplitLargeFreeBlock) {
+    my_vector::ListMemoryResource resource;
+
+    // два блока по 32 КиБ занимают кусок целиком - других свободных блоков нет
+    void* big = resource.allocate(32 * 1024, 16);
+    void* guard = resource.allocate(32 * 1024, 16);
+    resource.deallocate(big, 32 * 1024, 16);
+
+    void* small = resource.allocate(4, 4);
+    void* second = resource.allocate(4, 4);
+    EXPECT_EQ(small, big);
+    EXPECT_NE(second, small);
+    // вторая аллокация нарезана из остатка того же освобождённого блока
+    EXPECT_LT(static_cast<char*>(second) - static_cast<char*>(big), 32 * 1024);
+    EXPECT_GE(resource.largest_free_block(), 32 * 1024 - 64);
+
+    resource.deallocate(small, 4, 4);
+    resource.deallocate(second, 4, 4);
+    resource.deallocate(guard, 32 * 1024, 16);
+}
+
+// === 33. Слияние соседних свободных блоков и метрика фрагментации ===
+TEST(ListMemoryResourceTest, CoalesceAndFragmentation) {
+    my_vector::ListMemoryResource resource;
+
+    std::vector<void*> ptrs;
+    for (int i = 0; i < 64; ++i) {
+        ptrs.push_back(resource.allocate(256, 16));
+    }
+    size_t reserved = resource.reserved_bytes();
+
+    // освобождаем через один - свободная память раздроблена
+    for (size_t i = 0; i < ptrs.size(); i += 2) {
+        resource.deallocate(ptrs[i], 256, 16);
+    }
+    EXPECT_GT(resource.fragmentation(), 0.0);
+    EXPECT_EQ(resource.free_bytes(), reserved - 32 * 256);
+
+    // освобождаем остальные - всё сливается обратно в один блок на кусок
+    for (size_t i = 1; i < ptrs.size(); i += 2) {
+        resource.deallocate(ptrs[i], 256, 16);
+    }
+    EXPECT_EQ(resource.free_bytes(), reserved);
+    EXPECT_EQ(resource.largest_free_block(), reserved);
+    EXPECT_DOUBLE_EQ(resource.fragmentation(), 0.0);
+
+    // после слияния большой запрос обслуживается без нового куска
+    void* big = resource.allocate(64 * 256, 16);
+    EXPECT_EQ(resource.reserved_bytes(), reserved);
+    resource.deallocate(big, 64 * 256, 16);
+}
+
+// === 34. Выравнивание больше стандартного ===
+TEST(ListMemoryResourceTest, OverAlignedRequests) {
+    my_vector::ListMemoryResource resource;
+
+    void* a = resource.allocate(8, 8);
+    void* b = resource.allocate(100, 64);
+    void* c = resource.allocate(10, 4096);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(b) % 64, 0);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(c) % 4096, 0);
+
+    resource.deallocate(b, 100, 64);
+    resource.deallocate(a, 8, 8);
+    resource.deallocate(c, 10, 4096);
+    EXPECT_DOUBLE_EQ(resource.fragmentation(), 0.0);
+}
+
+// === 35. shrink_to_fit возвращает память после clear() и массового erase ===
+TEST(PmrVectorTrimTest, ShrinkToFit) {
+    CountingResource resource;
+    my_vector::PmrVector<int> vec(&resource);
+    for (int i = 0; i < 5000; ++i) {
+        vec.push_back(i);
+    }
+    int* survivor = &vec[4999];
+
+    vec.erase(0, 4999);
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.capacity(), 1);
+    EXPECT_EQ(&vec[0], survivor);
+    EXPECT_EQ(vec[0], 4999);
+    // остались только таблица и кусок с выжившим элементом
+    EXPECT_EQ(resource.allocations - resource.deallocations, 2);
+
+    vec.clear();
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.capacity(), 0);
+    EXPECT_EQ(resource.allocations, resource.deallocations);
+
+    vec.push_back(7);
+    EXPECT_EQ(vec.back(), 7);
+
+    my_vector::PmrDenseVector<int> dense(&resource);
+    dense.reserve(100);
+    dense.push_back(1);
+    dense.shrink_to_fit();
+    EXPECT_EQ(dense.capacity(), 1);
+    EXPECT_EQ(dense[0], 1);
+}
+
+// === 36. trim() и release() возвращают куски системе ===
+TEST(ListMemoryResourceTest, TrimAndRelease) {
+    my_vector::ListMemoryResource resource;
+
+    std::vector<void*> ptrs;
+    for (int i = 0; i < 8; ++i) {
+        ptrs.push_back(resource.allocate(40 * 1024, 16)); // каждый блок - отдельный кусок
+    }
+    size_t reserved = resource.reserved_bytes();
+    for (size_t i = 0; i < 6; ++i) {
+        resource.deallocate(ptrs[i], 40 * 1024, 16);
+    }
+
+    // оставляем не больше одного свободного куска
+    size_t released = resource.trim(resource.reserved_bytes() / 8);
+    EXPECT_GT(released, 0);
+    EXPECT_EQ(resource.reserved_bytes(), reserved - released);
+    EXPECT_LE(resource.free_bytes(), reserved / 8);
+
+    // живые блоки не тронуты, память снова выделяется
+    void* again = resource.allocate(40 * 1024, 16);
+    resource.deallocate(again, 40 * 1024, 16);
+    resource.deallocate(ptrs[6], 40 * 1024, 16);
+
+    resource.release();
+    EXPECT_EQ(resource.reserved_bytes(), 0);
+    EXPECT_EQ(resource.free_bytes(), 0);
+    EXPECT_THROW(resource.deallocate(ptrs[7], 40 * 1024, 16), std::runtime_error);
+}
+
+// === 37. Автоматический возврат памяти по верхней границе ===
+TEST(ListMemoryResourceTest, RetentionLimit) {
+    my_vector::ListMemoryResource resource;
+    resource.set_retention_limit(128 * 1024);
+
+    {
+        my_vector::PmrVector<std::array<char, 1024>> vec(&resource);
+        for (int i = 0; i < 1000; ++i) {
+            vec.emplace_back();
+        }
+        EXPECT_GT(resource.reserved_bytes(), 1000 * 1024);
+    }
+    EXPECT_LE(resource.free_bytes(), 128 * 1024);
+}
+
+// === 38. Куски памяти берутся у upstream-ресурса ===
+TEST(ListMemoryResourceUpstreamTest, ChunksComeFromUpstream) {
+    CountingResource upstream;
+    {
+        my_vector::ListMemoryResource resource(&upstream);
+        EXPECT_EQ(resource.upstream_resource(), &upstream);
+
+        my_vector::PmrVector<int> vec(&resource);
+        for (int i = 0; i < 1000; ++i) {
+            vec.push_back(i);
+        }
+        EXPECT_GE(upstream.allocations, 1);
+        EXPECT_LT(upstream.allocations, 5);
+    }
+    EXPECT_EQ(upstream.allocations, upstream.deallocations);
+}
+
+// === 39. Арена: первые аллокации без обращений к upstream ===
+TEST(ListMemoryResourceUpstreamTest, PreWarmedArena) {
+    for (bool use_mmap : {false, true}) {
+        CountingResource upstream;
+        my_vector::ListMemoryResourceOptions options;
+        options.upstream = &upstream;
+        options.arena_bytes = 1 << 20;
+        options.arena_mmap = use_mmap;
+        options.arena_huge_pages = use_mmap;
+        {
+            my_vector::ListMemoryResource resource(options);
+            size_t after_construction = upstream.allocations;
+            EXPECT_EQ(after_construction, use_mmap ? 0 : 1);
+
+            {
+                my_vector::PmrVector<std::string> vec(&resource);
+                for (int i = 0; i < 5000; ++i) {
+                    vec.emplace_back("record");
+                }
+            }
+            EXPECT_EQ(upstream.allocations, after_construction);
+
+            // арена переживает release() и trim()
+            resource.trim(0);
+            resource.release();
+            EXPECT_EQ(resource.reserved_bytes(), size_t{1} << 20);
+            void* p = resource.allocate(100, 8);
+            resource.deallocate(p, 100, 8);
+            EXPECT_EQ(upstream.allocations, after_construction);
+        }
+        EXPECT_EQ(upstream.allocations, upstream.deallocations);
+    }
+}
+
+// === 40. Прогрев по записанному профилю ёмкости ===
+TEST(ListMemoryResourceUpstreamTest, WarmUpFromProfile) {
+    my_vector::CapacityProfile profile;
+    {
+        my_vector::ListMemoryResource recorder;
+        std::vector<void*> live;
+        for (int i = 0; i < 10; ++i) {
+            live.push_back(recorder.allocate(48, 8));
+        }
+        live.push_back(recorder.allocate(1000, 8));
+        profile = recorder.capacity_profile();
+        for (size_t i = 0; i < 10; ++i) {
+            recorder.deallocate(live[i], 48, 8);
+        }
+        recorder.deallocate(live[10], 1000, 8);
+    }
+    ASSERT_EQ(profile.size(), 2);
+    EXPECT_EQ(profile[0].bytes, 48);
+    EXPECT_EQ(profile[0].count, 10);
+
+    CountingResource upstream;
+    my_vector::ListMemoryResource resource(&upstream);
+    resource.warm_up(profile);
+    size_t warmed = upstream.allocations;
+    size_t free_before = resource.free_bytes();
+
+    std::vector<void*> ptrs;
+    for (int i = 0; i < 10; ++i) {
+        ptrs.push_back(resource.allocate(48, 8));
+    }
+    EXPECT_EQ(upstream.allocations, warmed);
+    EXPECT_EQ(resource.free_bytes(), free_before - 10 * 48);
+    for (void* p : ptrs) {
+        resource.deallocate(p, 48, 8);
+    }
+}
+
+#if __has_include(<sys/mman.h>)
+#include "../include/persistent_vector.h"
+#include <unistd.h>
+
+struct PersistentRecord {
+    int id;
+    double salary;
+};
+
+std::string temp_file(const std::string& name) {
+    auto path = std::filesystem::temp_directory_path() / ("lab5_" + name + "_" + std::to_string(::getpid()));
+    std::filesystem::remove(path);
+    return path.string();
+}
+
+// === 41. Вектор в отображённом файле переживает "перезапуск" ===
+TEST(PersistentVectorTest, ReopenKeepsElements) {
+    std::string path = temp_file("reopen");
+    {
+        my_vector::PersistentVector<PersistentRecord> vec(path);
+        EXPECT_TRUE(vec.empty());
+        for (int i = 0; i < 10000; ++i) {
+            vec.push_back({i, i * 1.5});
+        }
+        vec.pop_back();
+        vec.sync();
+    }
+    {
+        my_vector::PersistentVector<PersistentRecord> vec(path);
+        ASSERT_EQ(vec.size(), 9999);
+        EXPECT_GE(vec.capacity(), 9999);
+        EXPECT_EQ(vec[1234].id, 1234);
+        EXPECT_DOUBLE_EQ(vec.back().salary, 9998 * 1.5);
+        vec.push_back({-1, 0.0});
+    }
+    {
+        my_vector::PersistentVector<PersistentRecord> vec(path);
+        EXPECT_EQ(vec.size(), 10000);
+        EXPECT_EQ(vec.back().id, -1);
+        vec.shrink_to_fit();
+        EXPECT_EQ(std::filesystem::file_size(path) % sizeof(PersistentRecord), 0);
+    }
+    // другой тип элемента - ошибка, а не мусор
+    EXPECT_THROW(my_vector::PersistentVector<int> wrong(path), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+// === 42. Восстановление после усечения файла ===
+TEST(PersistentVectorTest, TruncationRecovery) {
+    std::string path = temp_file("truncate");
+    size_t full_size = 0;
+    {
+        my_vector::PersistentVector<int> vec(path);
+        for (int i = 0; i < 100; ++i) {
+            vec.push_back(i);
+        }
+        vec.shrink_to_fit();
+        full_size = std::filesystem::file_size(path);
+    }
+
+    // обрезаем 10 целых элементов и половину ещё одного
+    std::filesystem::resize_file(path, full_size - 10 * sizeof(int) - sizeof(int) / 2);
+    {
+        my_vector::PersistentVector<int> vec(path);
+        ASSERT_EQ(vec.size(), 89);
+        EXPECT_EQ(vec.back(), 88);
+        vec.push_back(89);
+        EXPECT_EQ(vec[89], 89);
+    }
+
+    // файл короче заголовка - начинаем с пустого вектора
+    std::filesystem::resize_file(path, 8);
+    {
+        my_vector::PersistentVector<int> vec(path);
+        EXPECT_TRUE(vec.empty());
+    }
+    std::filesystem::remove(path);
+}
+#endif
+
+
+struct SnapshotEmployee {
+    std::pmr::string name;
+    int id = 0;
+
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+    SnapshotEmployee(std::string_view n, int i, const allocator_type& alloc = {}) : name(n, alloc), id(i) {}
+    SnapshotEmployee(const SnapshotEmployee& other, const allocator_type& alloc = {}) : name(other.name, alloc), id(other.id) {}
+};
+
+template<>
+struct my_vector::Serializer<SnapshotEmployee> {
+    static void write(SnapshotWriter& out, const SnapshotEmployee& value) {
+        Serializer<std::pmr::string>::write(out, value.name);
+        out.write_value(value.id);
+    }
+
+    template<typename Emplace>
+    static void read(SnapshotReader& in, Emplace&& emplace) {
+        uint64_t length = in.read_value<uint64_t>();
+        if (length > in.remaining()) {
+            throw std::runtime_error("snapshot is truncated");
+        }
+        std::string name(static_cast<size_t>(length), '\0');
+        in.read(name.data(), name.size());
+        emplace(std::string_view(name), in.read_value<int>());
+    }
+};
+
+// === 43. Снимок тривиально копируемых элементов: save/load и контрольная сумма ===
+TEST(PmrVectorSnapshotTest, TriviallyCopyableRoundTrip) {
+    my_vector::ListMemoryResource resource;
+    my_vector::PmrVector<int> vec(&resource);
+    for (int i = 0; i < 50000; ++i) {
+        vec.push_back(i * 3);
+    }
+
+    std::stringstream stream;
+    my_vector::save(vec, stream);
+
+    CountingResource counting;
+    my_vector::PmrVector<int> loaded(&counting);
+    my_vector::load(loaded, stream);
+    ASSERT_EQ(loaded.size(), 50000);
+    EXPECT_EQ(loaded[49999], 49999 * 3);
+    // таблица указателей и один кусок слотов
+    EXPECT_EQ(counting.allocations, 2);
+
+    // испорченный байт данных ловится контрольной суммой
+    std::string bytes = stream.str();
+    bytes[100] ^= 0x5a;
+    std::stringstream corrupted(bytes);
+    EXPECT_THROW(my_vector::load(loaded, corrupted), std::runtime_error);
+    EXPECT_EQ(loaded.size(), 50000); // при ошибке прежнее содержимое сохраняется
+
+    std::stringstream truncated(stream.str().substr(0, 1000));
+    EXPECT_THROW(my_vector::load(loaded, truncated), std::runtime_error);
+
+    std::stringstream wrong_type(stream.str());
+    my_vector::PmrVector<double> doubles(&resource);
+    EXPECT_THROW(my_vector::load(doubles, wrong_type), std::runtime_error);
+}
+
+// === 44. Снимок строк и записей: префикс длины, память из ресурса вектора ===
+TEST(PmrVectorSnapshotTest, LengthPrefixedRoundTrip) {
+    std::string path = (std::filesystem::temp_directory_path() / "lab5_snapshot.bin").string();
+    my_vector::ListMemoryResource resource;
+    {
+        my_vector::PmrVector<std::pmr::string> names(&resource);
+        names.emplace_back("Valentin Zaitsev, a rather long name to avoid SSO");
+        names.emplace_back("");
+        names.emplace_back("Donald Knuth");
+        my_vector::save(names, path);
+    }
+    my_vector::PmrVector<std::pmr::string> names(&resource);
+    my_vector::load(names, path);
+    ASSERT_EQ(names.size(), 3);
+    EXPECT_EQ(names[0], "Valentin Zaitsev, a rather long name to avoid SSO");
+    EXPECT_EQ(names[1], "");
+    EXPECT_EQ(names[0].get_allocator().resource(), &resource);
+
+    my_vector::PmrVector<SnapshotEmployee> staff(&resource);
+    staff.emplace_back("Vladimir", 777);
+    staff.emplace_back("Donald Knuth, The Art of Computer Programming", 778);
+    std::stringstream stream;
+    my_vector::save(staff, stream);
+
+    my_vector::PmrVector<SnapshotEmployee> restored(&resource);
+    my_vector::load(restored, stream);
+    ASSERT_EQ(restored.size(), 2);
+    EXPECT_EQ(restored[1].id, 778);
+    EXPECT_EQ(restored[1].name, staff[1].name);
+    EXPECT_EQ(restored[1].name.get_allocator().resource(), &resource);
+    std::filesystem::remove(path);
+}
+
+struct SoAEmployee {
+    std::string name;
+    int id = 0;
+    double salary = 0.0;
+};
+
+using EmployeeColumns = my_vector::PmrSoAVector<SoAEmployee, &SoAEmployee::name, &SoAEmployee::id, &SoAEmployee::salary>;
+
+// === 45. Столбцовый контейнер: раздельные столбцы и сборка записи ===
+TEST(PmrSoAVectorTest, ColumnsAndRecords) {
+    my_vector::ListMemoryResource resource;
+    EmployeeColumns staff(&resource);
+
+    staff.push_back({"Valentin Zaitsev", 776, 77600.0});
+    staff.push_back({"Vladimir Putin", 777, 77777.0});
+    staff.push_back({"Donald Knuth", 778, 88888.0});
+
+    ASSERT_EQ(staff.size(), 3);
+    auto salaries = staff.column<&SoAEmployee::salary>();
+    EXPECT_EQ(salaries.size(), 3);
+    EXPECT_EQ(&salaries[1], &salaries[0] + 1);
+
+    SoAEmployee knuth = staff.get(2);
+    EXPECT_EQ(knuth.name, "Donald Knuth");
+    EXPECT_EQ(knuth.id, 778);
+
+    staff.column<&SoAEmployee::salary>()[0] = 85000.0;
+    EXPECT_DOUBLE_EQ(staff.get(0).salary, 85000.0);
+
+    staff.pop_back();
+    EXPECT_EQ(staff.size(), 2);
+    EXPECT_THROW(staff.get(2), std::out_of_range);
+}
+
+// === 46. Агрегаты sum/min/max/filter по числовым столбцам ===
+TEST(PmrSoAVectorTest, VectorizedAggregates) {
+    EmployeeColumns staff;
+    double expected_sum = 0.0;
+    int64_t expected_ids = 0;
+    for (int i = 0; i < 1003; ++i) {
+        double salary = 1000.0 + (i * 37) % 501;
+        staff.push_back({"worker", i - 500, salary});
+        expected_sum += salary;
+        expected_ids += i - 500;
+    }
+
+    EXPECT_NEAR(staff.sum<&SoAEmployee::salary>(), expected_sum, 1e-6);
+    EXPECT_EQ(staff.sum<&SoAEmployee::id>(), expected_ids);
+    EXPECT_EQ(staff.min<&SoAEmployee::id>(), -500);
+    EXPECT_EQ(staff.max<&SoAEmployee::id>(), 502);
+    EXPECT_DOUBLE_EQ(staff.min<&SoAEmployee::salary>(), 1000.0);
+    EXPECT_DOUBLE_EQ(staff.max<&SoAEmployee::salary>(), 1500.0);
+
+    auto rich = staff.filter<&SoAEmployee::salary>([](double s) { return s > 1450.0; });
+    EXPECT_EQ(rich.size(), staff.count_if<&SoAEmployee::salary>([](double s) { return s > 1450.0; }));
+    for (size_t index : rich) {
+        EXPECT_GT(staff.get(index).salary, 1450.0);
+    }
+    EXPECT_TRUE(std::is_sorted(rich.begin(), rich.end()));
+
+    EmployeeColumns empty;
+    EXPECT_EQ(empty.sum<&SoAEmployee::salary>(), 0.0);
+    EXPECT_THROW(empty.min<&SoAEmployee::id>(), std::runtime_error);
+}
+
+// === 47. Короткий вектор со встроенной ёмкостью не обращается к ресурсу ===
+TEST(PmrVectorInlineTest, NoAllocationsWithinInlineCapacity) {
+    CountingResource resource;
+    {
+        my_vector::PmrVector<std::string, 4> vec(&resource);
+        EXPECT_EQ(vec.capacity(), 4);
+        vec.push_back("a");
+        vec.emplace_back(3, 'b');
+        vec.insert(0, std::string("c"));
+        vec.push_back("d");
+        vec.erase(1);
+        vec.push_back("e");
+        EXPECT_EQ(resource.allocations, 0);
+        EXPECT_EQ(vec.size(), 4);
+        EXPECT_EQ(vec[0], "c");
+        EXPECT_EQ(vec[1], "bbb");
+        EXPECT_EQ(vec[3], "e");
+
+        // пятый элемент выходит за встроенный буфер
+        vec.push_back("f");
+        EXPECT_GT(resource.allocations, 0);
+        EXPECT_EQ(vec.capacity(), 8);
+        EXPECT_EQ(vec[4], "f");
+        EXPECT_EQ(vec[0], "c");
+
+        vec.erase(0, 4);
+        vec.shrink_to_fit();
+        EXPECT_EQ(vec.capacity(), 4);
+        EXPECT_EQ(vec[0], "f");
+    }
+    EXPECT_EQ(resource.allocations, resource.deallocations);
+}
+
+// === 48. Перемещение переносит элементы из встроенного буфера, адреса в пуле сохраняются ===
+TEST(PmrVectorInlineTest, MoveRelocatesInlineElements) {
+    CountingResource resource;
+    {
+        my_vector::PmrVector<std::string, 2> source(&resource);
+        for (int i = 0; i < 5; ++i) {
+            source.push_back(std::string(20, static_cast<char>('a' + i)));
+        }
+        std::string* spilled = &source[4];
+
+        my_vector::PmrVector<std::string, 2> target(std::move(source));
+        EXPECT_TRUE(source.empty());
+        EXPECT_EQ(source.capacity(), 2);
+        ASSERT_EQ(target.size(), 5);
+        for (int i = 0; i < 5; ++i) {
+            EXPECT_EQ(target[i], std::string(20, static_cast<char>('a' + i)));
+        }
+        EXPECT_EQ(&target[4], spilled);
+
+        // вектор-источник снова пригоден к работе
+        source.push_back("again");
+        EXPECT_EQ(source[0], "again");
+
+        my_vector::PmrVector<std::string, 2> small(&resource);
+        small.push_back("x");
+        target = std::move(small);
+        ASSERT_EQ(target.size(), 1);
+        EXPECT_EQ(target[0], "x");
+        EXPECT_EQ(target.capacity(), 2);
+    }
+    EXPECT_EQ(resource.allocations, resource.deallocations);
+}
+
+// === 49. StatsResource: счётчики, байты, классы размеров и повторное использование ===
+TEST(StatsResourceTest, CountsOperationsAndReuse) {
+    my_vector::ListMemoryResource list;
+    my_vector::StatsResource stats(&list);
+
+    void* a = stats.allocate(100);
+    void* b = stats.allocate(1000);
+    stats.deallocate(a, 100);
+    // ListMemoryResource отдаёт освободившийся блок того же размера повторно
+    void* c = stats.allocate(100);
+    EXPECT_EQ(a, c);
+
+    my_vector::AllocStats s = stats.stats();
+    EXPECT_EQ(s.allocations, 3);
+    EXPECT_EQ(s.deallocations, 1);
+    EXPECT_EQ(s.reuse_hits, 1);
+    EXPECT_DOUBLE_EQ(s.reuse_rate(), 1.0 / 3.0);
+    EXPECT_EQ(s.bytes_live, 1100);
+    EXPECT_EQ(s.bytes_peak, 1100);
+    EXPECT_EQ(s.bytes_freed, 100);
+    EXPECT_EQ(s.size_classes[7], 2);  // (64, 128]
+    EXPECT_EQ(s.size_classes[10], 1); // (512, 1024]
+    EXPECT_EQ(std::accumulate(s.lifetime_ns.begin(), s.lifetime_ns.end(), uint64_t{0}), 1);
+
+    stats.deallocate(b, 1000);
+    stats.deallocate(c, 100);
+    s = stats.stats();
+    EXPECT_EQ(s.bytes_live, 0);
+    EXPECT_EQ(s.bytes_peak, 1100);
+    EXPECT_LE(s.allocate_p50_ns, s.allocate_p99_ns);
+    EXPECT_LE(s.allocate_p99_ns, s.allocate_p999_ns);
+
+    stats.reset();
+    EXPECT_EQ(stats.stats().allocations, 0);
+}
+
+// === 50. Квантили гистограммы задержек и вывод в JSON ===
+TEST(StatsResourceTest, LatencyPercentilesAndJson) {
+    my_vector::LatencyHistogram histogram;
+    EXPECT_EQ(histogram.percentile(0.5), 0);
+    for (uint64_t v = 1; v <= 1000; ++v) {
+        histogram.record(v);
+    }
+    EXPECT_EQ(histogram.count(), 1000);
+    // ошибка корзины - не больше 1/16 значения
+    EXPECT_NEAR(static_cast<double>(histogram.percentile(0.5)), 500.0, 500.0 / 16);
+    EXPECT_NEAR(static_cast<double>(histogram.percentile(0.99)), 990.0, 990.0 / 16);
+    EXPECT_EQ(histogram.percentile(1.0), 1000);
+
+    my_vector::StatsResource stats;
+    {
+        my_vector::PmrVector<int> vec(&stats);
+        for (int i = 0; i < 100; ++i) {
+            vec.push_back(i);
+        }
+    }
+    std::ostringstream out;
+    stats.dump_json(out);
+    std::string json = out.str();
+    for (const char* key : {"\"allocations\"", "\"reuse_rate\"", "\"bytes_peak\"", "\"size_classes_log2\"",
+                            "\"lifetime_ns_log2\"", "\"allocate_latency_ns\"", "\"p999\""}) {
+        EXPECT_NE(json.find(key), std::string::npos) << key;
+    }
+    EXPECT_EQ(stats.stats().bytes_live, 0);
+}
+
+// === 51. ConcurrentPmrVector: параллельное добавление из нескольких потоков ===
+TEST(ConcurrentPmrVectorTest, ParallelPushBackKeepsEveryElement) {
+    constexpr int kThreads = 8;
+    constexpr int kPerThread = 20000;
+    my_vector::ConcurrentListMemoryResource resource;
+    my_vector::ConcurrentPmrVector<int64_t> vec(&resource);
+
+    std::atomic<bool> mismatch{false};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < kPerThread; ++i) {
+                int64_t value = int64_t{t} * kPerThread + i;
+                size_t index = vec.push_back(value);
+                // элемент сразу доступен по выданному индексу, пока другие потоки растят вектор
+                if (vec[index] != value) {
+                    mismatch = true;
+                }
+            }
+            resource.flush_thread_cache();
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+
+    EXPECT_FALSE(mismatch);
+    ASSERT_EQ(vec.size(), size_t{kThreads} * kPerThread);
+    std::vector<int64_t> seen;
+    vec.for_each([&](size_t, int64_t value) { seen.push_back(value); });
+    ASSERT_EQ(seen.size(), vec.size());
+    std::sort(seen.begin(), seen.end());
+    for (size_t i = 0; i < seen.size(); ++i) {
+        ASSERT_EQ(seen[i], static_cast<int64_t>(i));
+    }
+}
+
+// === 52. Адреса стабильны при росте, исключение в конструкторе оставляет пустой слот ===
+TEST(ConcurrentPmrVectorTest, StableAddressesAndFailedSlots) {
+    struct Fragile {
+        std::string text;
+        explicit Fragile(int i) : text(std::to_string(i)) {
+            if (i == 3) {
+                throw std::runtime_error("fragile");
+            }
+        }
+    };
+
+    CountingResource resource;
+    {
+        my_vector::ConcurrentPmrVector<Fragile> vec(&resource);
+        EXPECT_EQ(vec.try_get(0), nullptr);
+        vec.emplace_back(0);
+        Fragile* first = &vec[0];
+        for (int i = 1; i < 1000; ++i) {
+            if (i == 3) {
+                EXPECT_THROW(vec.emplace_back(i), std::runtime_error);
+            } else {
+                vec.emplace_back(i);
+            }
+        }
+        EXPECT_EQ(first, &vec[0]);
+        EXPECT_EQ(vec.size(), 1000);
+        EXPECT_EQ(vec.try_get(3), nullptr);
+        EXPECT_THROW(vec.at(3), std::out_of_range);
+        EXPECT_THROW(vec.at(1000), std::out_of_range);
+        EXPECT_EQ(vec.at(999).text, "999");
+        // сегменты растут вдвое: 8 + 16 + ... - немного аллокаций на 1000 элементов
+        EXPECT_LE(resource.allocations, 7);
+    }
+    EXPECT_EQ(resource.allocations, resource.deallocations);
+}
+
+// === 53. Параллельные for_each/transform/reduce/count_if совпадают с последовательными ===
+TEST(ParallelTest, AlgorithmsMatchSequentialResults) {
+    my_vector::ListMemoryResource resource;
+    my_vector::PmrVector<SoAEmployee> staff(&resource);
+    for (int i = 0; i < 100000; ++i) {
+        staff.push_back({"worker", i, 1000.0 + i % 1000});
+    }
+
+    my_vector::parallel::ThreadPool pool(4);
+    EXPECT_EQ(pool.size(), 4);
+
+    my_vector::parallel::for_each(pool, staff, [](SoAEmployee& e) { e.salary *= 2; });
+    double expected = 0.0;
+    for (const auto& e : staff) {
+        expected += e.salary;
+    }
+    double total = my_vector::parallel::reduce(pool, staff, 0.0, std::plus<>{}, &SoAEmployee::salary);
+    EXPECT_NEAR(total, expected, 1e-3);
+
+    size_t rich = my_vector::parallel::count_if(pool, staff, [](const auto& e) { return e.salary > 3000.0; });
+    EXPECT_EQ(rich, static_cast<size_t>(std::ranges::count_if(staff, [](const auto& e) { return e.salary > 3000.0; })));
+
+    my_vector::PmrVector<int> ids(&resource);
+    ids.resize(staff.size());
+    my_vector::parallel::transform(pool, staff, ids, [](const auto& e) { return e.id; });
+    for (size_t i = 0; i < ids.size(); ++i) {
+        ASSERT_EQ(ids[i], static_cast<int>(i));
+    }
+
+    my_vector::PmrVector<int> short_out(&resource);
+    EXPECT_THROW(my_vector::parallel::transform(pool, staff, short_out, [](const auto& e) { return e.id; }),
+                 std::out_of_range);
+
+    my_vector::PmrVector<int> empty(&resource);
+    EXPECT_EQ(my_vector::parallel::reduce(pool, empty, 7), 7);
+}
+
+// === 54. Исключения, вложенные вызовы, пул без потоков и scratch-ресурс ===
+TEST(ParallelTest, ExceptionsNestingAndScratch) {
+    my_vector::PmrVector<int> values;
+    for (int i = 0; i < 20000; ++i) {
+        values.push_back(i);
+    }
+
+    my_vector::parallel::ThreadPool pool(3);
+    EXPECT_THROW(my_vector::parallel::for_each(pool, values,
+                                               [](int v) {
+                                                   if (v == 12345) {
+                                                       throw std::runtime_error("bad element");
+                                                   }
+                                               }),
+                 std::runtime_error);
+
+    // вложенный параллельный вызов внутри задачи пула не блокируется, временные данные - в scratch
+    std::atomic<int64_t> nested{0};
+    my_vector::parallel::for_each(pool, values, [&](int v) {
+        if (v % 5000 == 0) {
+            std::pmr::vector<int> tmp(my_vector::parallel::scratch_resource());
+            tmp.assign(values.begin(), values.begin() + 100);
+            nested += my_vector::parallel::reduce(pool, tmp, int64_t{0});
+        }
+    }, 256);
+    EXPECT_EQ(nested.load(), 4 * (99 * 100 / 2));
+
+    my_vector::parallel::ThreadPool inline_pool(0);
+    EXPECT_EQ(my_vector::parallel::count_if(inline_pool, values, [](int v) { return v % 2 == 0; }), 10000);
+}
+
+// === 55. Отложенное удаление: надгробия, обход живых элементов и compact ===
+TEST(PmrVectorTombstoneTest, MarkErasedAndCompact) {
+    CountingResource resource;
+    {
+        my_vector::PmrVector<std::string> vec(&resource);
+        for (int i = 0; i < 10; ++i) {
+            vec.push_back("item-" + std::to_string(i));
+        }
+        std::string* keep = &vec[7];
+
+        for (size_t i = 0; i < 10; i += 3) {
+            vec.mark_erased(i); // 0, 3, 6, 9
+        }
+        vec.mark_erased(3); // повторная пометка ничего не меняет
+        EXPECT_EQ(vec.size(), 10);
+        EXPECT_EQ(vec.tombstone_count(), 4);
+        EXPECT_EQ(vec.live_size(), 6);
+        EXPECT_TRUE(vec.is_erased(6));
+        EXPECT_FALSE(vec.is_erased(7));
+        EXPECT_EQ(vec[7], "item-7"); // индексы живых элементов не сдвинулись
+        EXPECT_THROW(vec.at(3), std::out_of_range);
+        EXPECT_THROW(vec.mark_erased(10), std::out_of_range);
+
+        std::vector<std::string> live(vec.live().begin(), vec.live().end());
+        EXPECT_EQ(live, (std::vector<std::string>{"item-1", "item-2", "item-4", "item-5", "item-7", "item-8"}));
+
+        // сохранение в снимок пропускает надгробия
+        std::stringstream snapshot;
+        my_vector::save(vec, snapshot);
+        my_vector::PmrVector<std::string> restored;
+        my_vector::load(restored, snapshot);
+        EXPECT_EQ(restored.size(), 6);
+
+        EXPECT_EQ(vec.compact(), 4);
+        EXPECT_EQ(vec.size(), 6);
+        EXPECT_EQ(vec.tombstone_count(), 0);
+        EXPECT_EQ(vec[4], "item-7");
+        EXPECT_EQ(&vec[4], keep); // элементы не перемещались, сдвинулись только указатели
+        EXPECT_EQ(vec.compact(), 0);
+
+        // надгробия корректно обрабатываются остальными операциями
+        vec.mark_erased(5);
+        vec.pop_back();
+        vec.mark_erased(0);
+        vec.erase(0, 2);
+        EXPECT_EQ(vec.tombstone_count(), 0);
+        EXPECT_EQ(vec.size(), 3);
+        vec.mark_erased(1);
+        EXPECT_EQ(vec.erase_if([](const std::string& s) { return s == "item-4"; }), 1);
+        EXPECT_EQ(vec.size(), 1);
+        EXPECT_EQ(vec[0], "item-7");
+        vec.mark_erased(0);
+    }
+    EXPECT_EQ(resource.allocations, resource.deallocations);
+}
+
+// === 56. Автоматическое уплотнение по доле надгробий и swap_erase за O(1) ===
+TEST(PmrVectorTombstoneTest, AutoCompactionAndSwapErase) {
+    my_vector::PmrVector<int> vec;
+    for (int i = 0; i < 100; ++i) {
+        vec.push_back(i);
+    }
+    vec.set_compaction_ratio(0.25);
+    EXPECT_THROW(vec.set_compaction_ratio(1.5), std::out_of_range);
+    for (size_t i = 0; i < 25; ++i) {
+        vec.mark_erased(i);
+    }
+    EXPECT_EQ(vec.tombstone_count(), 25); // ровно 25% - порог ещё не превышен
+    vec.mark_erased(25);
+    EXPECT_EQ(vec.tombstone_count(), 0);
+    EXPECT_EQ(vec.size(), 74);
+    EXPECT_EQ(vec.front(), 26);
+
+    vec.swap_erase(0);
+    EXPECT_EQ(vec.size(), 73);
+    EXPECT_EQ(vec.front(), 99);
+    EXPECT_EQ(vec.back(), 98);
+
+    vec.set_compaction_ratio(0.0);
+    vec.mark_erased(72);        // надгробие в конце
+    vec.swap_erase(0);          // на место 0 переезжает надгробие
+    EXPECT_TRUE(vec.is_erased(0));
+    EXPECT_EQ(vec.tombstone_count(), 1);
+    vec.swap_erase(0);          // удаляем само надгробие
+    EXPECT_EQ(vec.tombstone_count(), 0);
+    EXPECT_EQ(vec.size(), 71);
+    EXPECT_EQ(vec.front(), 97);
+    EXPECT_EQ(std::ranges::distance(vec.live()), 71);
+    EXPECT_THROW(vec.swap_erase(71), std::out_of_range);
+}
+
+// === 57. RecordingResource: запись трассы PmrVector, сохранение и воспроизведение ===
+TEST(AllocationTraceTest, RecordSaveAndReplay) {
+    my_vector::RecordingResource recorder;
+    {
+        my_vector::PmrVector<std::string> vec(&recorder);
+        for (int i = 0; i < 500; ++i) {
+            vec.push_back(std::string(40, 'x'));
+        }
+        vec.erase(0, 250);
+        vec.shrink_to_fit();
+    }
+
+    my_vector::AllocationTrace trace = recorder.trace();
+    ASSERT_GT(trace.allocation_count, 0);
+    size_t allocations = std::ranges::count_if(trace.records, [](const my_vector::AllocRecord& r) {
+        return r.kind == my_vector::AllocRecord::Kind::Allocate;
+    });
+    EXPECT_EQ(allocations, trace.allocation_count);
+    // все выделения освобождены
+    EXPECT_EQ(trace.records.size(), 2 * allocations);
+
+    std::stringstream file;
+    trace.write(file);
+    // компактный формат: в среднем меньше 4 байт на операцию
+    EXPECT_LT(file.str().size(), 32 + 4 * trace.records.size());
+
+    my_vector::AllocationTrace loaded = my_vector::AllocationTrace::read(file);
+    ASSERT_EQ(loaded.records.size(), trace.records.size());
+    for (size_t i = 0; i < trace.records.size(); ++i) {
+        EXPECT_EQ(loaded.records[i].kind, trace.records[i].kind);
+        EXPECT_EQ(loaded.records[i].size_or_id, trace.records[i].size_or_id);
+        EXPECT_EQ(loaded.records[i].alignment, trace.records[i].alignment);
+    }
+
+    CountingResource counting;
+    my_vector::ReplayResult result = my_vector::replay(loaded, &counting);
+    EXPECT_EQ(result.operations, trace.records.size());
+    EXPECT_EQ(counting.allocations, allocations);
+    EXPECT_EQ(counting.deallocations, allocations);
+    EXPECT_EQ(result.leaked, 0);
+
+    // ListMemoryResource повторно выдаёт освобождённые при росте таблицы указателей блоки
+    my_vector::ListMemoryResource list;
+    EXPECT_GT(my_vector::replay(loaded, &list).reuse_rate, 0.0);
+}
+
+// === 58. Ошибки трассы: чужой указатель, повреждённый и обрезанный файл ===
+TEST(AllocationTraceTest, RejectsInvalidInput) {
+    my_vector::RecordingResource recorder;
+    int outside = 0;
+    EXPECT_THROW(recorder.deallocate(&outside, sizeof(int)), std::runtime_error);
+
+    void* p = recorder.allocate(64, 16);
+    my_vector::AllocationTrace unfinished = recorder.trace();
+    recorder.deallocate(p, 64, 16);
+
+    CountingResource counting;
+    EXPECT_EQ(my_vector::replay(unfinished, &counting).leaked, 1);
+    EXPECT_EQ(counting.allocations, counting.deallocations);
+
+    std::stringstream garbage("definitely not a trace");
+    EXPECT_THROW(my_vector::AllocationTrace::read(garbage), std::runtime_error);
+
+    std::stringstream full;
+    recorder.trace().write(full);
+    std::string bytes = full.str();
+    std::stringstream truncated(bytes.substr(0, bytes.size() - 1));
+    EXPECT_THROW(my_vector::AllocationTrace::read(truncated), std::runtime_error);
+
+    my_vector::AllocationTrace twice = recorder.trace();
+    twice.records.push_back(twice.records.back());
+    EXPECT_THROW(my_vector::replay(twice, &counting), std::runtime_error);
+}
+
+// === 59. sort/stable_sort/partition/nth_element переставляют только указатели ===
+TEST(PmrVectorPermutationTest, ReorderWithoutMovingElements) {
+    my_vector::PmrVector<SoAEmployee> staff;
+    std::mt19937 rng(7);
+    for (int i = 0; i < 1000; ++i) {
+        staff.push_back({"worker-" + std::to_string(i), i, static_cast<double>(rng() % 100)});
+    }
+    std::set<const SoAEmployee*> addresses;
+    for (const auto& e : staff) {
+        addresses.insert(&e);
+    }
+    const SoAEmployee* employee_42 = &staff[42];
+
+    staff.sort(std::ranges::greater{}, &SoAEmployee::id);
+    EXPECT_EQ(staff.front().id, 999);
+    EXPECT_EQ(staff.back().id, 0);
+    EXPECT_EQ(&staff[999 - 42], employee_42); // тот же объект, только другой индекс
+
+    staff.stable_sort({}, &SoAEmployee::salary);
+    EXPECT_TRUE(std::ranges::is_sorted(staff, {}, &SoAEmployee::salary));
+    // внутри равных зарплат сохранился порядок по убыванию id
+    for (size_t i = 1; i < staff.size(); ++i) {
+        if (staff[i - 1].salary == staff[i].salary) {
+            EXPECT_GT(staff[i - 1].id, staff[i].id);
+        }
+    }
+
+    size_t split = staff.partition([](int id) { return id % 2 == 0; }, &SoAEmployee::id);
+    EXPECT_EQ(split, 500);
+    for (size_t i = 0; i < staff.size(); ++i) {
+        EXPECT_EQ(staff[i].id % 2 == 0, i < split);
+    }
+
+    staff.nth_element(500, {}, &SoAEmployee::id);
+    EXPECT_EQ(staff[500].id, 500);
+    EXPECT_THROW(staff.nth_element(1000, {}, &SoAEmployee::id), std::out_of_range);
+
+    std::set<const SoAEmployee*> after;
+    for (const auto& e : staff) {
+        after.insert(&e);
+    }
+    EXPECT_EQ(addresses, after);
+}
+
+// === 60. unique и поиск в отсортированном векторе по проекции ===
+TEST(PmrVectorPermutationTest, UniqueAndSortedLookup) {
+    CountingResource resource;
+    {
+        my_vector::PmrVector<SoAEmployee> staff(&resource);
+        for (int i = 0; i < 300; ++i) {
+            staff.push_back({"worker", i / 3, 1000.0 + i});
+        }
+        staff.mark_erased(0); // надгробие уберётся перед сортировкой
+        staff.sort({}, &SoAEmployee::id);
+
+        auto [first, last] = staff.equal_range(10, {}, &SoAEmployee::id);
+        EXPECT_EQ(last - first, 3);
+        EXPECT_EQ(staff[first].id, 10);
+        EXPECT_EQ(staff.lower_bound(10, {}, &SoAEmployee::id), first);
+        EXPECT_EQ(staff.upper_bound(10, {}, &SoAEmployee::id), last);
+        EXPECT_EQ(staff.lower_bound(1000, {}, &SoAEmployee::id), staff.size());
+
+        EXPECT_EQ(staff.unique({}, &SoAEmployee::id), 199);
+        ASSERT_EQ(staff.size(), 100);
+        for (int i = 0; i < 100; ++i) {
+            EXPECT_EQ(staff[i].id, i);
+        }
+        EXPECT_EQ(staff.lower_bound(57, {}, &SoAEmployee::id), 57);
+
+        my_vector::PmrVector<int> numbers(&resource);
+        for (int v : {1, 1, 2, 3, 3, 3, 1}) {
+            numbers.push_back(v);
+        }
+        EXPECT_EQ(numbers.unique(), 3);
+        EXPECT_EQ(std::vector<int>(numbers.begin(), numbers.end()), (std::vector<int>{1, 2, 3, 1}));
+    }
+    EXPECT_EQ(resource.allocations, resource.deallocations);
+}
+
+// Тип с владеющим указателем: отмечен как тривиально перемещаемый, перемещения считаются
+struct RelocatableHandle {
+    static inline int moves = 0;
+    std::unique_ptr<int> value;
+
+    explicit RelocatableHandle(int v) : value(std::make_unique<int>(v)) {}
+    RelocatableHandle(RelocatableHandle&& other) noexcept : value(std::move(other.value)) { ++moves; }
+    RelocatableHandle& operator=(RelocatableHandle&& other) noexcept { value = std::move(other.value); ++moves; return *this; }
+};
+
+template<>
+struct my_vector::is_trivially_relocatable<RelocatableHandle> : std::true_type {};
+
+// === 61. Тривиально перемещаемые типы переносятся memcpy/memmove без конструкторов ===
+TEST(RelocationTest, DenseVectorRelocatesWithoutMoves) {
+    static_assert(my_vector::is_trivially_relocatable_v<int>);
+    static_assert(!my_vector::is_trivially_relocatable_v<std::string>);
+
+    CountingResource resource;
+    {
+        my_vector::PmrDenseVector<RelocatableHandle> vec(&resource);
+        vec.reserve(100);
+        RelocatableHandle::moves = 0;
+        for (int i = 0; i < 100; ++i) {
+            vec.emplace_back(i);
+        }
+        vec.reserve(1000);
+        vec.emplace(0, -1);
+        vec.erase(50);
+        vec.shrink_to_fit();
+        // перенос буфера и сдвиги не вызывают перемещающий конструктор; остаётся только
+        // перенос временного объекта в emplace
+        EXPECT_EQ(RelocatableHandle::moves, 1);
+        ASSERT_EQ(vec.size(), 100);
+        EXPECT_EQ(*vec[0].value, -1);
+        EXPECT_EQ(*vec[1].value, 0);
+        EXPECT_EQ(*vec[50].value, 50);
+        EXPECT_EQ(*vec[99].value, 99);
+    }
+    // unique_ptr внутри элементов освобождены ровно один раз - иначе ASan сообщил бы о двойном освобождении
+    EXPECT_EQ(resource.allocations, resource.deallocations);
+}
+
+// === 62. clear() для тривиально разрушаемых типов возвращает все слоты пулу разом ===
+TEST(RelocationTest, TrivialClearRecyclesSlots) {
+    CountingResource resource;
+    {
+        my_vector::PmrVector<int, 4> vec(&resource);
+        for (int i = 0; i < 5000; ++i) {
+            vec.push_back(i);
+        }
+        vec.mark_erased(10);
+        size_t allocations = resource.allocations;
+
+        vec.clear();
+        EXPECT_TRUE(vec.empty());
+        EXPECT_EQ(vec.tombstone_count(), 0);
+        for (int i = 0; i < 5000; ++i) {
+            vec.push_back(-i);
+        }
+        // слоты и таблица переиспользованы без обращений к ресурсу
+        EXPECT_EQ(resource.allocations, allocations);
+        EXPECT_EQ(vec[4999], -4999);
+        EXPECT_EQ(std::accumulate(vec.begin(), vec.end(), int64_t{0}), -int64_t{4999} * 5000 / 2);
+
+        vec.clear();
+        vec.reserve(100);
+        EXPECT_EQ(resource.allocations, allocations);
+        size_t deallocations = resource.deallocations;
+        vec.shrink_to_fit(); // пустые куски возвращаются ресурсу
+        EXPECT_GT(resource.deallocations, deallocations);
+    }
+    EXPECT_EQ(resource.allocations, resource.deallocations);
+}
+
+// === 63. defragment() укладывает элементы подряд в порядке индексов и освобождает старые куски ===
+TEST(PmrVectorDefragmentTest, RelocatesElementsContiguously) {
+    CountingResource resource;
+    {
+        my_vector::PmrVector<std::string, 2> vec(&resource);
+        std::mt19937 rng(3);
+        for (int i = 0; i < 2000; ++i) {
+            vec.push_back("value-" + std::to_string(i));
+        }
+        // перемешиваем порядок и создаём дыры в пуле
+        vec.sort({}, [](const std::string& s) { return std::hash<std::string>{}(s); });
+        for (int round = 0; round < 500; ++round) {
+            vec.erase(rng() % vec.size());
+            vec.insert(rng() % vec.size(), "inserted-" + std::to_string(round));
+        }
+        vec.mark_erased(100);
+        std::vector<std::string> expected(vec.live().begin(), vec.live().end());
+
+        size_t allocations = resource.allocations;
+        size_t moved = vec.defragment();
+        EXPECT_EQ(vec.tombstone_count(), 0);
+        ASSERT_EQ(vec.size(), expected.size());
+        EXPECT_TRUE(std::equal(vec.begin(), vec.end(), expected.begin()));
+
+        // элементы встроенного буфера на месте, остальные идут подряд в порядке индексов
+        size_t pooled = 0;
+        const std::string* previous = nullptr;
+        for (const std::string& s : vec) {
+            auto* bytes = reinterpret_cast<const std::byte*>(&s);
+            bool in_object = bytes >= reinterpret_cast<const std::byte*>(&vec) &&
+                             bytes < reinterpret_cast<const std::byte*>(&vec) + sizeof(vec);
+            if (in_object) {
+                continue;
+            }
+            if (previous) {
+                EXPECT_EQ(&s, previous + 1);
+            }
+            previous = &s;
+            ++pooled;
+        }
+        EXPECT_EQ(moved, pooled * sizeof(std::string));
+        EXPECT_EQ(resource.allocations, allocations + 1); // один новый кусок
+        // у ресурса остались только таблица указателей и этот кусок
+        EXPECT_EQ(resource.allocations - resource.deallocations, 2);
+
+        // повторная дефрагментация тоже сохраняет содержимое
+        vec.push_back("tail");
+        vec.defragment();
+        EXPECT_EQ(vec.back(), "tail");
+        EXPECT_EQ(vec[0], expected[0]);
+    }
+    EXPECT_EQ(resource.allocations, resource.deallocations);
+}
+
+// === 64. Потоковая загрузка: записи на границах кусков, строки в ресурсе вектора ===
+TEST(IngestTest, DelimitedRecordsAcrossChunkBoundaries) {
+    std::string input = "name;id\r\n";
+    for (int i = 0; i < 500; ++i) {
+        input += "employee number " + std::to_string(i) + " with a long name;" + std::to_string(i) + "\r\n";
+        if (i % 100 == 0) {
+            input += "\n"; // пустые строки пропускаются
+        }
+    }
+    input += "last;-1"; // без завершающего перевода строки
+
+    CountingResource resource;
+    {
+        my_vector::PmrVector<SnapshotEmployee> staff(&resource);
+        my_vector::IngestOptions options;
+        options.chunk_bytes = 7; // меньше одной записи: каждая собирается из нескольких кусков
+        options.delimiter = ';';
+        options.skip_header = true;
+        std::istringstream stream(input);
+        auto stats = my_vector::ingest_delimited(stream, staff, [](auto& vec, std::span<const std::string_view> fields) {
+            ASSERT_EQ(fields.size(), 2);
+            vec.emplace_back(fields[0], my_vector::parse_field<int>(fields[1]));
+        }, options);
+
+        ASSERT_EQ(staff.size(), 501);
+        EXPECT_EQ(stats.records, 501);
+        EXPECT_EQ(stats.bytes, input.size());
+        EXPECT_EQ(staff[0].name, "employee number 0 with a long name");
+        EXPECT_EQ(staff[499].id, 499);
+        EXPECT_EQ(staff.back().name, "last");
+        EXPECT_EQ(staff.back().id, -1);
+        // длинные имена не помещаются в SSO и выделены из ресурса вектора
+        EXPECT_EQ(staff[250].name.get_allocator().resource(), &resource);
+        EXPECT_GT(resource.allocations, 500);
+    }
+    EXPECT_EQ(resource.allocations, resource.deallocations);
+}
+
+// === 65. Потоковая загрузка: ограниченная буферизация, ошибки разбора, двоичный вход ===
+TEST(IngestTest, BackpressureErrorsAndBinaryInput) {
+    std::string input;
+    for (int i = 0; i < 20000; ++i) {
+        input += std::to_string(i) + "\n";
+    }
+    my_vector::ListMemoryResource resource;
+    my_vector::IngestOptions options;
+    options.chunk_bytes = 256;
+    options.max_batches_in_flight = 2;
+    options.max_record_bytes = 16;
+
+    my_vector::PmrVector<int> numbers(&resource);
+    std::istringstream stream(input);
+    auto stats = my_vector::ingest_delimited(stream, numbers, [](auto& vec, std::span<const std::string_view> fields) {
+        // медленный потребитель: производитель упирается в ограничение очереди
+        if (vec.size() % 1000 == 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        vec.push_back(my_vector::parse_field<int>(fields[0]));
+    }, options);
+    ASSERT_EQ(numbers.size(), 20000);
+    EXPECT_EQ(numbers[12345], 12345);
+    EXPECT_GT(stats.batches, 50);
+    // Учитываются все пачки (очередь + по одной у стадий), таблицы полей и хвост.
+    // Текст пачки - не больше куска и хвоста; поле "N\n" занимает минимум 2 байта;
+    // ёмкость векторов растёт не больше чем вдвое
+    const size_t text = options.chunk_bytes + options.max_record_bytes;
+    const size_t per_batch = 2 * (text + text / 2 * (sizeof(std::string_view) + sizeof(uint32_t)));
+    EXPECT_LE(stats.peak_buffered_bytes, (options.max_batches_in_flight + 2) * per_batch + 2 * text);
+    // таблица полей пачки больше самого текста - она входит в учёт
+    EXPECT_GT(stats.peak_buffered_bytes, 2 * options.chunk_bytes);
+    EXPECT_GT(stats.mb_per_second(), 0.0);
+
+    // ошибка разбора останавливает производителя и пробрасывается вызывающему
+    my_vector::PmrVector<int> broken(&resource);
+    std::istringstream bad(input + "oops\n" + input);
+    EXPECT_THROW(my_vector::ingest_delimited(bad, broken, [](auto& vec, std::span<const std::string_view> fields) {
+        vec.push_back(my_vector::parse_field<int>(fields[0]));
+    }, options), std::runtime_error);
+    EXPECT_EQ(broken.size(), 20000);
+
+    // двоичный вход: подряд записанные тривиально копируемые записи
+    std::string binary;
+    for (int i = 0; i < 5000; ++i) {
+        binary.append(reinterpret_cast<const char*>(&i), sizeof(i));
+    }
+    my_vector::PmrVector<int> loaded(&resource);
+    std::istringstream binary_stream(binary);
+    auto binary_stats = my_vector::ingest_binary(binary_stream, loaded, options);
+    ASSERT_EQ(loaded.size(), 5000);
+    EXPECT_EQ(loaded[4999], 4999);
+    EXPECT_EQ(binary_stats.bytes, binary.size());
+
+    std::istringstream truncated(binary.substr(0, binary.size() - 1));
+    my_vector::PmrVector<int> partial(&resource);
+    EXPECT_THROW(my_vector::ingest_binary(truncated, partial, options), std::runtime_error);
+}
+
+// === 66. erase_if: исключение из предиката оставляет вектор целым ===
+TEST(PmrVectorExceptionTest, EraseIfThrowingPredicateKeepsVectorConsistent) {
+    CountingResource resource;
+    {
+        my_vector::PmrVector<std::string> vec(&resource);
+        for (int i = 0; i < 8; ++i) {
+            vec.push_back("long string number " + std::to_string(i) + " outside of SSO");
+        }
+        vec.mark_erased(5);
+        int calls = 0;
+        EXPECT_THROW(vec.erase_if([&](const std::string& s) {
+            if (++calls == 4) {
+                throw std::runtime_error("predicate failed");
+            }
+            return s.find("number 1 ") != std::string::npos || s.find("number 2 ") != std::string::npos;
+        }), std::runtime_error);
+
+        // удалены 1 и 2, элемент 3 (на котором бросили) и хвост с надгробием сохранены
+        ASSERT_EQ(vec.size(), 6);
+        EXPECT_EQ(vec.tombstone_count(), 1);
+        EXPECT_EQ(vec.at(0), "long string number 0 outside of SSO");
+        EXPECT_EQ(vec.at(1), "long string number 3 outside of SSO");
+        EXPECT_TRUE(vec.is_erased(3));
+        EXPECT_EQ(vec.at(5), "long string number 7 outside of SSO");
+        EXPECT_EQ(vec.erase_if([](const std::string&) { return false; }), 0);
+        EXPECT_EQ(vec.size(), 5);
+    }
+    EXPECT_EQ(resource.allocations, resource.deallocations);
+}
+
+// === 67. unique: исключение из сравнения оставляет вектор целым ===
+TEST(PmrVectorExceptionTest, UniqueThrowingComparatorKeepsVectorConsistent) {
+    CountingResource resource;
+    {
+        my_vector::PmrVector<std::string> vec(&resource);
+        for (const char* word : {"alpha", "alpha", "beta", "beta", "gamma", "delta"}) {
+            vec.push_back(std::string(word) + " padded beyond the small string buffer");
+        }
+        int calls = 0;
+        EXPECT_THROW(vec.unique([&](const std::string& a, const std::string& b) {
+            if (++calls == 3) {
+                throw std::runtime_error("comparator failed");
+            }
+            return a == b;
+        }), std::runtime_error);
+
+        // второй "alpha" удалён, второй "beta" (на котором бросили) и хвост сохранены
+        ASSERT_EQ(vec.size(), 5);
+        EXPECT_EQ(vec.at(0).substr(0, 5), "alpha");
+        EXPECT_EQ(vec.at(1).substr(0, 4), "beta");
+        EXPECT_EQ(vec.at(2).substr(0, 4), "beta");
+        EXPECT_EQ(vec.at(4).substr(0, 5), "delta");
+        EXPECT_EQ(vec.unique(), 1);
+        EXPECT_EQ(vec.size(), 4);
+    }
+    EXPECT_EQ(resource.allocations, resource.deallocations);
+}
+
+// === 68. load: испорченный счётчик или обрыв снимка не трогают вектор и не резервируют лишнего ===
+TEST(PmrVectorSnapshotTest, CorruptedCountLeavesVectorIntact) {
+    my_vector::ListMemoryResource resource;
+    my_vector::PmrVector<int> source(&resource);
+    for (int i = 0; i < 1000; ++i) {
+        source.push_back(i);
+    }
+    std::stringstream stream;
+    my_vector::save(source, stream);
+    const std::string snapshot = stream.str();
+    const size_t count_offset = 24; // magic, version, layout, element_size
+
+    my_vector::PmrVector<int> target(&resource);
+    target.push_back(42);
+
+    std::string inflated = snapshot;
+    uint64_t huge = uint64_t{1} << 33;
+    std::memcpy(inflated.data() + count_offset, &huge, sizeof(huge));
+    std::istringstream inflated_stream(inflated);
+    EXPECT_THROW(my_vector::load(target, inflated_stream), std::runtime_error);
+    ASSERT_EQ(target.size(), 1);
+    EXPECT_EQ(target[0], 42);
+    EXPECT_LT(target.capacity(), 1000);
+
+    std::istringstream truncated(snapshot.substr(0, snapshot.size() - 100));
+    EXPECT_THROW(my_vector::load(target, truncated), std::runtime_error);
+    ASSERT_EQ(target.size(), 1);
+
+    // длина строки тоже берётся из файла
+    my_vector::PmrVector<std::string> words(&resource);
+    words.push_back("word");
+    std::stringstream words_stream;
+    my_vector::save(words, words_stream);
+    std::string broken = words_stream.str();
+    std::memcpy(broken.data() + sizeof(uint64_t) * 4, &huge, sizeof(huge));
+    std::istringstream broken_stream(broken);
+    EXPECT_THROW(my_vector::load(words, broken_stream), std::runtime_error);
+    ASSERT_EQ(words.size(), 1);
+    EXPECT_EQ(words[0], "word");
+
+    std::istringstream valid(snapshot);
+    my_vector::load(target, valid);
+    ASSERT_EQ(target.size(), 1000);
+    EXPECT_EQ(target[999], 999);
+}
+
+// === 69. StatsResource: учёт из многих потоков не теряет блоки при повторной выдаче адресов ===
+TEST(StatsResourceTest, ConcurrentReuseKeepsLiveTracking) {
+    my_vector::ConcurrentListMemoryResource upstream;
+    my_vector::StatsResource stats(&upstream);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&stats] {
+            for (int i = 0; i < 5000; ++i) {
+                void* p = stats.allocate(64, 8);
+                stats.deallocate(p, 64, 8);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    my_vector::AllocStats result = stats.stats();
+    EXPECT_EQ(result.allocations, 20000);
+    EXPECT_EQ(result.deallocations, 20000);
+    EXPECT_EQ(result.bytes_live, 0);
+    // каждое освобождение нашло свой блок на учёте и записало время жизни
+    uint64_t lifetimes = std::accumulate(result.lifetime_ns.begin(), result.lifetime_ns.end(), uint64_t{0});
+    EXPECT_EQ(lifetimes, result.deallocations);
+    EXPECT_GT(result.reuse_hits, 0);
+}
+
+// === 70. Потоковая загрузка: запись длиннее max_record_bytes - ошибка, а не рост буфера ===
+TEST(IngestTest, OversizedRecordIsRejected) {
+    my_vector::ListMemoryResource resource;
+    my_vector::IngestOptions options;
+    options.chunk_bytes = 64;
+    options.max_record_bytes = 100;
+    auto emplace = [](auto& vec, std::span<const std::string_view> fields) {
+        vec.push_back(std::string(fields[0]));
+    };
+
+    // запись без конца: раньше буфер рос до размера всего входа
+    std::istringstream endless(std::string(100000, 'x'));
+    my_vector::PmrVector<std::string> first(&resource);
+    EXPECT_THROW(my_vector::ingest_delimited(endless, first, emplace, options), std::runtime_error);
+
+    // длинная запись внутри куска и в конце входа
+    options.chunk_bytes = 4096;
+    std::istringstream inside("short\n" + std::string(200, 'y') + "\nshort\n");
+    my_vector::PmrVector<std::string> second(&resource);
+    EXPECT_THROW(my_vector::ingest_delimited(inside, second, emplace, options), std::runtime_error);
+
+    std::istringstream fits("short\n" + std::string(100, 'z'));
+    my_vector::PmrVector<std::string> third(&resource);
+    my_vector::ingest_delimited(fits, third, emplace, options);
+    ASSERT_EQ(third.size(), 2);
+    EXPECT_EQ(third[1].size(), 100);
+}
+
+// === 71. Трасса с завышенным числом записей не приводит к гигантскому резервированию ===
+TEST(AllocationTraceTest, InflatedRecordCountIsRejected) {
+    my_vector::RecordingResource recorder;
+    for (int i = 0; i < 100; ++i) {
+        recorder.deallocate(recorder.allocate(32, 8), 32, 8);
+    }
+    std::stringstream full;
+    recorder.trace().write(full);
+    std::string bytes = full.str();
+
+    const size_t record_count_offset = 8; // magic, version
+    uint64_t huge = uint64_t{1} << 40;
+    std::memcpy(bytes.data() + record_count_offset, &huge, sizeof(huge));
+    std::stringstream inflated(bytes);
+    // обрыв входа, а не bad_alloc/length_error от reserve
+    EXPECT_THROW(my_vector::AllocationTrace::read(inflated), std::runtime_error);
+}
+
+// === 72. Кэши завершившихся потоков возвращаются в общий пул ===
+TEST(ConcurrentListMemoryResourceTest, ExitedThreadsReturnTheirCaches) {
+    my_vector::ConcurrentListMemoryResource resource;
+    auto round = [&resource] {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&resource] {
+                std::vector<void*> blocks;
+                for (int i = 0; i < 200; ++i) {
+                    blocks.push_back(resource.allocate(64, 8));
+                }
+                for (void* p : blocks) {
+                    resource.deallocate(p, 64, 8);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    };
+
+    round();
+    const size_t reserved = resource.reserved_bytes();
+    EXPECT_GT(reserved, 0);
+    // все блоки завершившихся потоков снова в общем пуле
+    EXPECT_EQ(resource.free_bytes(), reserved);
+
+    // новые потоки берут блоки из пула: память ограничена пиком одного раунда
+    // (4 потока по 200 блоков плюс не больше двух пачек в кэше каждого), а не растёт с числом потоков
+    for (int i = 0; i < 50; ++i) {
+        round();
+        EXPECT_EQ(resource.free_bytes(), resource.reserved_bytes());
+    }
+    EXPECT_LE(resource.reserved_bytes(), 4 * (200 * 64 + 2 * 16 * 1024));
+}
+
+// === 73. Поток, переживший ресурс, не трогает его при завершении ===
+TEST(ConcurrentListMemoryResourceTest, ThreadOutlivingResourceExitsCleanly) {
+    std::mutex mutex;
+    std::condition_variable ready;
+    bool allocated = false;
+    bool destroyed = false;
+    auto resource = std::make_unique<my_vector::ConcurrentListMemoryResource>();
+    std::thread worker([&] {
+        resource->deallocate(resource->allocate(128, 8), 128, 8);
+        std::unique_lock<std::mutex> lock(mutex);
+        allocated = true;
+        ready.notify_all();
+        ready.wait(lock, [&] { return destroyed; });
+    });
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ready.wait(lock, [&] { return allocated; });
+    }
+    resource.reset();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        destroyed = true;
+        ready.notify_all();
+    }
+    worker.join();
+
+    my_vector::ConcurrentListMemoryResource other;
+    other.deallocate(other.allocate(128, 8), 128, 8);
+}
+
+// === 74. trim() возвращает куски, нарезанные warm_up, даже без слияния блоков ===
+TEST(PmrVectorTrimTest, WarmedUpChunksAreTrimmed) {
+    CountingResource upstream;
+    {
+        my_vector::ListMemoryResource resource(&upstream);
+        resource.warm_up({{64, 100}, {256, 50}, {4096, 10}});
+        EXPECT_GT(resource.reserved_bytes(), 0);
+        EXPECT_EQ(resource.free_bytes(), resource.reserved_bytes());
+
+        resource.trim(0);
+        EXPECT_EQ(resource.reserved_bytes(), 0);
+        EXPECT_EQ(resource.free_bytes(), 0);
+        EXPECT_EQ(upstream.allocations, upstream.deallocations);
+
+        // куски с занятыми блоками остаются, после освобождения - тоже уходят
+        resource.warm_up({{64, 100}});
+        void* p = resource.allocate(64);
+        resource.trim(0);
+        EXPECT_GT(resource.reserved_bytes(), 0);
+        resource.deallocate(p, 64);
+        resource.trim(0);
+        EXPECT_EQ(resource.reserved_bytes(), 0);
+    }
+    EXPECT_EQ(upstream.allocations, upstream.deallocations);
+}
+
+// === 75. Вызовы ресурса после возврата кэшей потока и запросы больше 2^63 байт ===
+struct LateResourceUser {
+    my_vector::ConcurrentListMemoryResource* resource = nullptr;
+    void* block = nullptr;
+
+    // разрушается после списка кэшей потока: тот создан позже, при первом обращении к ресурсу
+    ~LateResourceUser() {
+        if (resource) {
+            resource->deallocate(block, 64, 8);
+            resource->deallocate(resource->allocate(32, 8), 32, 8);
+        }
+    }
+};
+
+TEST(ConcurrentListMemoryResourceTest, UseAfterThreadCachesReleased) {
+    my_vector::ConcurrentListMemoryResource resource;
+    std::thread worker([&resource] {
+        thread_local LateResourceUser late;
+        late.resource = &resource;
+        late.block = resource.allocate(64, 8);
+    });
+    worker.join();
+    EXPECT_EQ(resource.free_bytes(), resource.reserved_bytes());
+
+    // volatile - чтобы компилятор не ругался на заведомо невозможный размер
+    volatile size_t huge = SIZE_MAX;
+    EXPECT_THROW((void)resource.allocate(huge), std::bad_alloc);
+    huge = (size_t{1} << 63) + 1;
+    EXPECT_THROW((void)resource.allocate(huge), std::bad_alloc);
+}
+
+// === 76. Запрос размером около SIZE_MAX - bad_alloc, а не переполнение при округлении ===
+TEST(ListMemoryResourceTest, HugeRequestThrowsBadAlloc) {
+    CountingResource upstream;
+    my_vector::ListMemoryResource resource(&upstream);
+    volatile size_t huge = SIZE_MAX;
+    EXPECT_THROW((void)resource.allocate(huge), std::bad_alloc);
+    huge = SIZE_MAX - 8;
+    EXPECT_THROW((void)resource.allocate(huge), std::bad_alloc);
+    huge = SIZE_MAX - 8;
+    EXPECT_THROW((void)resource.allocate(huge, 1024), std::bad_alloc);
+    // до upstream такие запросы не доходят
+    EXPECT_EQ(upstream.allocations, 0);
+
+    // ресурс остаётся рабочим
+    void* p = resource.allocate(64);
+    resource.deallocate(p, 64);
+}
+
+// === 77. Потоковая загрузка мелкими кусками: таблица указателей растёт геометрически ===
+TEST(IngestTest, SmallChunksDoNotReallocatePerBatch) {
+    std::string input;
+    for (int i = 0; i < 20000; ++i) {
+        input += std::to_string(i) + "\n";
+    }
+    CountingResource resource;
+    {
+        my_vector::PmrVector<int> numbers(&resource);
+        my_vector::IngestOptions options;
+        options.chunk_bytes = 64;
+        std::istringstream stream(input);
+        auto stats = my_vector::ingest_delimited(stream, numbers, [](auto& vec, std::span<const std::string_view> fields) {
+            vec.push_back(my_vector::parse_field<int>(fields[0]));
+        }, options);
+        ASSERT_EQ(numbers.size(), 20000);
+        EXPECT_GT(stats.batches, 1000);
+        // на каждую пачку было бы по новой таблице; при удвоении - логарифм от числа элементов
+        EXPECT_LT(resource.allocations, 100);
+    }
+    EXPECT_EQ(resource.allocations, resource.deallocations);
+}
+
+// === 78. AllocTrace: точные метки времени в Chrome JSON и чтение параллельно с записью ===
+TEST(AllocTraceTest, ChromeTimestampsAndConcurrentDrain) {
+    my_vector::AllocTrace trace(8);
+    int dummy = 0;
+    trace.record(my_vector::TraceOp::Allocate, &dummy, 4, 4);
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+    trace.record(my_vector::TraceOp::Deallocate, &dummy, 4, 4);
+
+    std::ostringstream json;
+    trace.dump_chrome_json(json);
+    std::vector<std::string> stamps;
+    const std::string text = json.str();
+    for (size_t pos = text.find("\"ts\":"); pos != std::string::npos; pos = text.find("\"ts\":", pos + 1)) {
+        size_t start = pos + 5;
+        stamps.push_back(text.substr(start, text.find(',', start) - start));
+    }
+    ASSERT_EQ(stamps.size(), 4); // по событию и счётчику на каждую операцию
+    for (const std::string& ts : stamps) {
+        EXPECT_EQ(ts.find('e'), std::string::npos) << ts;
+        EXPECT_EQ(ts.size() - ts.find('.'), 4u) << ts; // три знака после точки
+    }
+    EXPECT_LT(std::stod(stamps[0]), std::stod(stamps[2]));
+
+    // событие собирается по словам: разорванных событий быть не должно
+    my_vector::AllocTrace ring(64);
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        for (uintptr_t i = 1; i <= 20000; ++i) {
+            ring.record(my_vector::TraceOp::Allocate, reinterpret_cast<const void*>(i), i, 8);
+        }
+        done = true;
+    });
+    std::vector<my_vector::TraceEvent> events;
+    while (!done.load()) {
+        ring.drain(events);
+    }
+    writer.join();
+    ring.drain(events);
+    EXPECT_FALSE(events.empty());
+    for (const my_vector::TraceEvent& e : events) {
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(e.ptr), e.size);
+    }
+}
+
+#if __has_include(<sys/mman.h>)
+// === 79. PersistentVector не затирает чужой короткий файл ===
+TEST(PersistentVectorTest, RejectsForeignSmallFile) {
+    std::string path = temp_file("foreign");
+    const std::string content = "hello foo\n";
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << content;
+    }
+    EXPECT_THROW(my_vector::PersistentVector<PersistentRecord>{path}, std::runtime_error);
+
+    std::ifstream in(path, std::ios::binary);
+    std::string kept((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(kept, content);
+    std::filesystem::remove(path);
+}
+
+// === 80. Неудачный resize оставляет прежнее отображение ===
+TEST(MappedFileTest, FailedResizeKeepsOldMapping) {
+    std::string path = temp_file("resize_fail");
+    {
+        my_vector::MappedFile file(path);
+        file.resize(4096);
+        std::memset(file.data(), 0x5A, 4096);
+
+        // такой размер не переживёт ни ftruncate, ни mmap
+        EXPECT_THROW(file.resize(size_t{1} << 62), std::runtime_error);
+        ASSERT_NE(file.data(), nullptr);
+        EXPECT_EQ(file.size(), 4096u);
+        EXPECT_EQ(std::to_integer<int>(file.data()[4095]), 0x5A);
+        EXPECT_EQ(std::filesystem::file_size(path), 4096u);
+
+        file.resize(128);
+        EXPECT_EQ(file.size(), 128u);
+        EXPECT_EQ(std::to_integer<int>(file.data()[127]), 0x5A);
+    }
+    std::filesystem::remove(path);
+}
+#endif
+
+// === 81. warm_up, прерванный исключением, не оставляет занятых блоков ===
+TEST(PmrVectorTrimTest, FailedWarmUpReleasesPreparedBlocks) {
+    CountingResource upstream;
+    {
+        my_vector::ListMemoryResource resource(&upstream);
+        volatile size_t huge = SIZE_MAX - 8;
+        EXPECT_THROW(resource.warm_up({{64, 100}, {huge, 1}}), std::bad_alloc);
+        EXPECT_TRUE(resource.capacity_profile().empty());
+        EXPECT_EQ(resource.free_bytes(), resource.reserved_bytes());
+
+        resource.trim(0);
+        EXPECT_EQ(resource.reserved_bytes(), 0);
+    }
+    EXPECT_EQ(upstream.allocations, upstream.deallocations);
+}
+
+// === 82. emplace в PmrDenseVector создаёт pmr-элементы через аллокатор вектора ===
+TEST(PmrDenseVectorTest, EmplacePropagatesResource) {
+    CountingResource counting;
+    my_vector::ListMemoryResource resource(&counting);
+    my_vector::PmrDenseVector<std::pmr::string> vec(&resource);
+    const std::pmr::string long_text(64, 'x'); // длиннее SSO - строка выделяет память
+
+    {
+        // временные объекты тоже должны создаваться на ресурсе вектора, а не на ресурсе по умолчанию
+        std::pmr::memory_resource* previous_default = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+        struct RestoreDefault {
+            std::pmr::memory_resource* previous;
+            ~RestoreDefault() {
+                std::pmr::set_default_resource(previous);
+            }
+        } restore{previous_default};
+
+        vec.emplace_back(long_text);          // рост с пустого буфера
+        vec.emplace_back(long_text, 1);       // без роста
+        vec.emplace_back(vec[0]);             // рост, аргумент - элемент этого же массива
+        vec.emplace(0, long_text, 2);         // вставка в середину с ростом
+        vec.emplace(1, vec.back());           // без роста, аргумент сдвигается вставкой
+    }
+
+    ASSERT_EQ(vec.size(), 5);
+    EXPECT_EQ(vec[0], long_text.substr(2));
+    EXPECT_EQ(vec[1], long_text);
+    EXPECT_EQ(vec[2], long_text);
+    EXPECT_EQ(vec[3], long_text.substr(1));
+    EXPECT_EQ(vec[4], long_text);
+    for (const std::pmr::string& s : vec) {
+        EXPECT_EQ(s.get_allocator().resource(), &resource);
+    }
+}
+
+// === 83. ConcurrentPmrVector конструирует pmr-элементы через аллокатор вектора ===
+TEST(ConcurrentPmrVectorTest, ElementsUseVectorResource) {
+    my_vector::ConcurrentListMemoryResource resource;
+    {
+        my_vector::ConcurrentPmrVector<std::pmr::string> vec(&resource);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&] {
+                for (int i = 0; i < 100; ++i) {
+                    vec.emplace_back(64, 'a' + i % 26); // длиннее SSO - строка выделяет память
+                }
+                resource.flush_thread_cache();
+            });
+        }
+        for (auto& th : threads) {
+            th.join();
+        }
+
+        ASSERT_EQ(vec.size(), 400);
+        size_t foreign = 0;
+        vec.for_each([&](size_t, const std::pmr::string& s) {
+            if (s.get_allocator().resource() != &resource) {
+                ++foreign;
+            }
+        });
+        EXPECT_EQ(foreign, 0);
+    }
+    resource.flush_thread_cache(); // строки освобождались в кэш этого потока
+    EXPECT_EQ(resource.free_bytes(), resource.reserved_bytes());
+}
+
+// === 84. PmrSoAVector не копируется неявно; перемещение в другой ресурс ===
+TEST(PmrSoAVectorTest, MoveToAnotherResource) {
+    static_assert(!std::is_copy_constructible_v<EmployeeColumns>);
+    static_assert(!std::is_copy_assignable_v<EmployeeColumns>);
+    static_assert(std::is_nothrow_move_constructible_v<EmployeeColumns>);
+
+    my_vector::ListMemoryResource first;
+    my_vector::ListMemoryResource second;
+    EmployeeColumns staff(&first);
+    staff.push_back({"Valentin Zaitsev", 776, 77600.0});
+    staff.push_back({"Donald Knuth", 778, 88888.0});
+
+    EmployeeColumns moved(std::move(staff));
+    EXPECT_EQ(moved.get_resource(), &first);
+
+    EmployeeColumns other(std::move(moved), &second);
+    EXPECT_EQ(other.get_resource(), &second);
+    ASSERT_EQ(other.size(), 2);
+    EXPECT_EQ(other.get(1).name, "Donald Knuth");
+    EXPECT_DOUBLE_EQ(other.get(0).salary, 77600.0);
+    EXPECT_GT(second.reserved_bytes(), 0);
+}
+
+// === 85. Снимок: тип без конструктора по умолчанию и ложный префикс длины ===
+struct SnapshotPoint {
+    int x;
+    int y;
+    SnapshotPoint(int px, int py) : x(px), y(py) {}
+};
+
+TEST(PmrVectorSnapshotTest, NonDefaultConstructibleAndHugeLength) {
+    static_assert(!std::is_default_constructible_v<SnapshotPoint>);
+    my_vector::ListMemoryResource resource;
+    my_vector::PmrVector<SnapshotPoint> points(&resource);
+    for (int i = 0; i < 1000; ++i) {
+        points.emplace_back(i, -i);
+    }
+    std::stringstream stream;
+    my_vector::save(points, stream);
+    my_vector::PmrVector<SnapshotPoint> loaded(&resource);
+    my_vector::load(loaded, stream);
+    ASSERT_EQ(loaded.size(), 1000);
+    EXPECT_EQ(loaded[999].x, 999);
+    EXPECT_EQ(loaded[999].y, -999);
+
+    my_vector::PmrVector<SnapshotEmployee> staff(&resource);
+    staff.emplace_back("Vladimir", 777);
+    std::stringstream saved;
+    my_vector::save(staff, saved);
+    // длина имени сразу за заголовком снимка
+    std::string bytes = saved.str();
+    uint64_t huge = uint64_t{1} << 60;
+    std::memcpy(bytes.data() + sizeof(my_vector::snapshot_detail::Header), &huge, sizeof(huge));
+
+    CountingResource counting;
+    my_vector::PmrVector<SnapshotEmployee> restored(&counting);
+    std::stringstream corrupted(bytes);
+    EXPECT_THROW(my_vector::load(restored, corrupted), std::runtime_error);
+    EXPECT_TRUE(restored.empty());
+}
+
+// === 86. front/back пропускают надгробия ===
+TEST(PmrVectorTombstoneTest, FrontBackSkipTombstones) {
+    my_vector::ListMemoryResource resource;
+    my_vector::PmrVector<int> vec(&resource);
+    for (int i = 0; i < 5; ++i) {
+        vec.push_back(i);
+    }
+    vec.mark_erased(0);
+    vec.mark_erased(1);
+    vec.mark_erased(4);
+    EXPECT_EQ(vec.front(), 2);
+    EXPECT_EQ(vec.back(), 3);
+    const auto& cvec = vec;
+    EXPECT_EQ(cvec.front(), 2);
+    EXPECT_EQ(cvec.back(), 3);
+
+    // остались одни надгробия - как у пустого вектора
+    vec.mark_erased(2);
+    vec.mark_erased(3);
+    EXPECT_FALSE(vec.empty());
+    EXPECT_THROW(vec.front(), std::runtime_error);
+    EXPECT_THROW(cvec.back(), std::runtime_error);
+}
+
+// === 87. Перемещение в другой ресурс, прерванное исключением, ничего не теряет ===
+struct MoveBomb {
+    static inline int alive = 0;
+    static inline int moves_left = 0;
+    std::pmr::string text;
+
+    explicit MoveBomb(int i) : text(64, static_cast<char>('a' + i % 26)) {
+        ++alive;
+    }
+    MoveBomb(MoveBomb&& other) : text(std::move(other.text)) {
+        if (moves_left-- == 0) {
+            throw std::runtime_error("move failed");
+        }
+        ++alive;
+    }
+    ~MoveBomb() {
+        --alive;
+    }
+};
+
+TEST(PmrVectorExceptionTest, CrossResourceMoveThrowingReleasesMovedElements) {
+    CountingResource first;
+    CountingResource second;
+    {
+        my_vector::PmrVector<MoveBomb> source(&first);
+        for (int i = 0; i < 10; ++i) {
+            source.emplace_back(i);
+        }
+        MoveBomb::moves_left = 5;
+        EXPECT_THROW((my_vector::PmrVector<MoveBomb>(std::move(source), &second)), std::runtime_error);
+        EXPECT_EQ(MoveBomb::alive, 10); // в источнике, уже перенесённые уничтожены
+        EXPECT_EQ(second.allocations, second.deallocations);
+
+        my_vector::PmrVector<MoveBomb> target(&second);
+        target.emplace_back(0);
+        MoveBomb::moves_left = 3;
+        EXPECT_THROW(target = std::move(source), std::runtime_error);
+        EXPECT_TRUE(target.empty());
+        EXPECT_EQ(MoveBomb::alive, 10);
+    }
+    EXPECT_EQ(MoveBomb::alive, 0);
+    EXPECT_EQ(first.allocations, first.deallocations);
+    EXPECT_EQ(second.allocations, second.deallocations);
+}